@@ -10,6 +10,7 @@
 
 #include <functional>
 #include <sstream>
+#include <stdexcept>
 #include <vector>
 
 double Widget::pi__ = 3.141592653589793;
@@ -192,6 +193,22 @@ double Widget::get_pi() HAL_NOEXCEPT {
   return pi__;
 }
 
+std::string Widget::repeat(const std::string& text, std::uint32_t count) const {
+  if (count == 0) {
+    throw std::invalid_argument("count must be positive");
+  }
+  std::string result;
+  for (std::uint32_t i = 0; i < count; ++i) {
+    result += text;
+  }
+  return result;
+}
+
+std::shared_ptr<JSThreadPool> Widget::GetThreadPool() {
+  static const auto thread_pool = std::make_shared<JSThreadPool>(1);
+  return thread_pool;
+}
+
 std::string Widget::sayHello() {
   std::ostringstream os;
   os << "Hello";
@@ -228,6 +245,7 @@ void Widget::JSExportInitialize() {
   JSExport<Widget>::AddFunctionProperty("testCallAsFunction", std::mem_fn(&Widget::js_testCallAsFunction));
   JSExport<Widget>::AddFunctionProperty("testException", std::mem_fn(&Widget::js_testException));
   JSExport<Widget>::AddFunctionProperty("testNestedException", std::mem_fn(&Widget::js_testNestedException));
+  JSExport<Widget>::AddAsyncFunctionProperty("repeatAsync", &Widget::repeat, GetThreadPool());
 }
 
 JSValue Widget::js_get_name() const HAL_NOEXCEPT {
@@ -10,6 +10,7 @@
 #define _HAL_EXAMPLES_WIDGET_HPP_
 
 #include "HAL/HAL.hpp"
+#include <memory>
 #include <string>
 #include <unordered_map>
 
@@ -50,6 +51,13 @@ public:
   static double get_pi() HAL_NOEXCEPT;
   
   std::string sayHello();
+  
+  // Runs on the thread pool below, so it must not use JavaScript
+  // values.
+  std::string repeat(const std::string& text, std::uint32_t count) const;
+  
+  // The single-threaded pool for the async function properties.
+  static std::shared_ptr<JSThreadPool> GetThreadPool();
 
   std::string testMemberObjectProperty() const HAL_NOEXCEPT;
   std::string testMemberArrayProperty()  const HAL_NOEXCEPT;
@@ -19,6 +19,7 @@
 #include "HAL/JSString.hpp"
 
 #include "HAL/JSValue.hpp"
+#include "HAL/JSExpected.hpp"
 #include "HAL/JSUndefined.hpp"
 #include "HAL/JSNull.hpp"
 #include "HAL/JSBoolean.hpp"
@@ -26,10 +27,23 @@
 
 #include "HAL/JSObject.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArrayBuilder.hpp"
+#include "HAL/JSObjectTemplate.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSTypedArray.hpp"
+#include "HAL/JSNativeArray.hpp"
+#include "HAL/JSDocumentProxy.hpp"
+#include "HAL/JSNativeIterator.hpp"
+#include "HAL/JSEventEmitter.hpp"
 #include "HAL/JSDate.hpp"
 #include "HAL/JSError.hpp"
+#include "HAL/JSArguments.hpp"
 #include "HAL/JSFunction.hpp"
+#include "HAL/JSCallBatcher.hpp"
+#include "HAL/JSPromise.hpp"
+#include "HAL/JSThreadPool.hpp"
 #include "HAL/JSRegExp.hpp"
+#include "HAL/JSCallable.hpp"
 
 #include "HAL/JSPropertyNameArray.hpp"
 
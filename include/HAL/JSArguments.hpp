@@ -0,0 +1,178 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSARGUMENTS_HPP_
+#define _HAL_JSARGUMENTS_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace HAL {
+
+  class JSContext;
+  class JSValue;
+  class JSObject;
+
+  /*!
+   @class
+
+   @discussion A JSArguments is a non-owning view of the arguments
+   given to a native callback by JavaScriptCore: the context, the
+   argument count and the raw argument values.
+
+   Creating a JSArguments costs nothing. An argument is wrapped in a
+   JSValue, and therefore protected from the garbage collector, only
+   when it is read with operator[] or to_vector. The Is and To member
+   functions read the raw values directly, so a callback that only
+   needs a number or a string from its arguments creates no wrappers
+   at all.
+
+   Reading an argument past the end of the view gives undefined, as it
+   does in JavaScript.
+
+   A JSArguments is only valid during the callback it was given to.
+   Keep a JSValue, not the JSArguments, to hold on to an argument.
+   */
+  class HAL_EXPORT JSArguments final HAL_PERFORMANCE_COUNTER1(JSArguments) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a view of the arguments of a JavaScriptCore C API
+     callback.
+
+     @discussion For interoperability with the JavaScriptCore C API.
+     */
+    JSArguments(JSContextRef context_ref, std::size_t count, const JSValueRef arguments[]) HAL_NOEXCEPT
+    : context_ref__(context_ref)
+    , count__(count)
+    , arguments__(arguments) {
+    }
+
+    /*!
+     @method
+
+     @abstract Return the number of arguments.
+     */
+    std::size_t size() const HAL_NOEXCEPT {
+      return count__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return whether there are no arguments.
+     */
+    bool empty() const HAL_NOEXCEPT {
+      return count__ == 0;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the raw argument values.
+
+     @discussion For interoperability with the JavaScriptCore C API.
+     */
+    const JSValueRef* data() const HAL_NOEXCEPT {
+      return arguments__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the execution context of the arguments.
+     */
+    JSContext get_context() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the argument at index as a JSValue, or undefined
+     if there is no such argument.
+     */
+    JSValue operator[](std::size_t index) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return all of the arguments as JSValues, as a
+     JSFunctionCallback is given them.
+     */
+    std::vector<JSValue> to_vector() const;
+
+    bool IsUndefined(std::size_t index) const HAL_NOEXCEPT;
+    bool IsNull(std::size_t index) const HAL_NOEXCEPT;
+    bool IsBoolean(std::size_t index) const HAL_NOEXCEPT;
+    bool IsNumber(std::size_t index) const HAL_NOEXCEPT;
+    bool IsString(std::size_t index) const HAL_NOEXCEPT;
+    bool IsObject(std::size_t index) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index to a boolean using the
+     same rules as the JSValue bool conversion operator.
+     */
+    bool ToBoolean(std::size_t index) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index to a number using the
+     same rules as the JSValue double conversion operator, i.e.
+     ToNumber. A missing argument converts to NaN.
+
+     @throws std::runtime_error if the conversion threw a JavaScript
+     exception, e.g. from a valueOf function.
+     */
+    double ToNumber(std::size_t index) const;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index to a number and then to
+     an int32_t or uint32_t using the JavaScript ToInt32 and ToUint32
+     rules.
+
+     @throws std::runtime_error if the conversion threw a JavaScript
+     exception.
+     */
+    int32_t  ToInt32(std::size_t index) const;
+    uint32_t ToUInt32(std::size_t index) const;
+
+    /*!
+     @method
+
+     @abstract Convert the argument at index to a UTF-8 string using
+     the JavaScript ToString rules. A missing argument converts to
+     "undefined".
+
+     @throws std::runtime_error if the conversion threw a JavaScript
+     exception, e.g. from a toString function.
+     */
+    std::string ToString(std::size_t index) const;
+
+  private:
+
+    JSValueRef GetJSValueRef(std::size_t index) const HAL_NOEXCEPT;
+
+    JSContextRef      context_ref__;
+    std::size_t       count__;
+    const JSValueRef* arguments__;
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSARGUMENTS_HPP_
@@ -12,6 +12,11 @@
 #include "HAL/JSObject.hpp"
 #include "HAL/JSValue.hpp"
 #include "HAL/JSString.hpp"
+#include <algorithm>
+#include <cstddef>
+#include <type_traits>
+#include <functional>
+#include <iterator>
 #include <vector>
 
 namespace HAL {
@@ -81,6 +86,29 @@ public:
      */
     virtual operator std::vector<uint32_t>() const final;
 
+    /*!
+     @method
+     
+     @abstract Copy this dense array of numbers into values in one
+     bulk operation.
+     
+     @discussion Unlike the std::vector conversion operators, which
+     silently convert holes and non-numbers, this method requires
+     every element to be present and to be a number. A single
+     scripted pass over the array checks each element and copies it
+     into a Float64Array, which is then copied out with one memcpy,
+     so no per-element JSValue is created on the native side.
+     
+     @param values Receives a copy of this array's elements.
+     
+     @throws std::invalid_argument naming the index of the first
+     element that is a hole or not a number, or for int32_t and
+     uint32_t not an integer representable in that type.
+     */
+    void CopyNumbersTo(std::vector<double>& values) const;
+    void CopyNumbersTo(std::vector<int32_t>& values) const;
+    void CopyNumbersTo(std::vector<uint32_t>& values) const;
+
     /*!
      @method
      
@@ -103,18 +131,154 @@ public:
     template<typename T>
     std::vector<std::shared_ptr<T>> GetPrivateItems() const HAL_NOEXCEPT;
 
+    /*!
+     @method
+     
+     @abstract Return borrowed pointers to the private data of this
+     array's elements in one pass.
+     
+     @discussion Each element's class is checked against
+     JSExport<T>::Class() with JSValueIsObjectOfClass, so unlike
+     GetPrivateItems no JSObject wrapper, std::shared_ptr or RTTI is
+     used per element. The pointers are owned by the JavaScript
+     objects and are only valid while those objects are reachable.
+     
+     @param items Optional caller-provided storage for at most count
+     pointers, which avoids allocating a std::vector.
+     
+     @result The pointers, or the number of pointers stored in items.
+     An element that is not an object of JSExport<T>::Class() yields
+     nullptr.
+     */
+    template<typename T>
+    std::vector<T*> GetPrivatePointers() const;
+    template<typename T>
+    std::size_t GetPrivatePointers(T* items[], std::size_t count) const;
+
+    /*!
+     @class
+     
+     @discussion A lazy iterator over the elements of a JSArray. Each
+     element is fetched only when the iterator is dereferenced, so
+     walking a JSArray never materializes all of its elements and a
+     loop may stop early at no extra cost.
+     
+     The iterator supports random-access arithmetic and comparison,
+     but dereferencing returns a JSValue by value rather than a
+     reference.
+     */
+    class const_iterator final {
+    public:
+      typedef std::input_iterator_tag iterator_category;
+      typedef JSValue                 value_type;
+      typedef std::ptrdiff_t          difference_type;
+      typedef void                    pointer;
+      typedef JSValue                 reference;
+
+      JSValue operator*() const {
+        return js_array__->GetProperty(index__);
+      }
+
+      JSValue operator[](std::ptrdiff_t offset) const {
+        return js_array__->GetProperty(static_cast<unsigned>(index__ + offset));
+      }
+
+      const_iterator& operator++()                    { ++index__; return *this; }
+      const_iterator  operator++(int)                 { auto result = *this; ++index__; return result; }
+      const_iterator& operator--()                    { --index__; return *this; }
+      const_iterator  operator--(int)                 { auto result = *this; --index__; return result; }
+      const_iterator& operator+=(std::ptrdiff_t offset) { index__ = static_cast<uint32_t>(index__ + offset); return *this; }
+      const_iterator& operator-=(std::ptrdiff_t offset) { index__ = static_cast<uint32_t>(index__ - offset); return *this; }
+      const_iterator  operator+(std::ptrdiff_t offset) const { auto result = *this; return result += offset; }
+      const_iterator  operator-(std::ptrdiff_t offset) const { auto result = *this; return result -= offset; }
+
+      std::ptrdiff_t operator-(const const_iterator& rhs) const { return static_cast<std::ptrdiff_t>(index__) - static_cast<std::ptrdiff_t>(rhs.index__); }
+      bool operator==(const const_iterator& rhs) const { return index__ == rhs.index__ && js_array__ == rhs.js_array__; }
+      bool operator!=(const const_iterator& rhs) const { return !(*this == rhs); }
+      bool operator< (const const_iterator& rhs) const { return index__ <  rhs.index__; }
+      bool operator> (const const_iterator& rhs) const { return index__ >  rhs.index__; }
+      bool operator<=(const const_iterator& rhs) const { return index__ <= rhs.index__; }
+      bool operator>=(const const_iterator& rhs) const { return index__ >= rhs.index__; }
+
+      // The index of the element this iterator refers to.
+      uint32_t get_index() const HAL_NOEXCEPT {
+        return index__;
+      }
+
+    private:
+      friend JSArray;
+
+      const_iterator(const JSArray* js_array, uint32_t index) HAL_NOEXCEPT
+      : js_array__(js_array)
+      , index__(index) {
+      }
+
+      const JSArray* js_array__;
+      uint32_t       index__;
+    };
+
+    /*!
+     @method
+     
+     @abstract Return lazy iterators over the elements of this
+     JSArray. The iterators refer to this JSArray, so it must outlive
+     them, and end() is computed from the length at the time it is
+     called.
+     */
+    const_iterator begin() const HAL_NOEXCEPT;
+    const_iterator end() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+     
+     @abstract Visit the elements of this JSArray in chunks of at most
+     chunk_size elements.
+     
+     @discussion Elements are fetched into a single reusable buffer,
+     and their JSValues are released after each chunk, so at most
+     chunk_size elements are protected from garbage collection at any
+     time no matter how long the array is.
+     
+     @param chunk_size The maximum number of elements per chunk. Zero
+     is treated as one.
+     
+     @param callback Called with the index of the first element of the
+     chunk and the chunk's elements. Return false to stop early.
+     
+     @result The number of elements visited.
+     */
+    std::size_t ForEachChunk(std::size_t chunk_size, const std::function<bool(uint32_t first_index, const std::vector<JSValue>& chunk)>& callback) const;
+
 private:
 
-	// Only JSContext and JSObject can create a JSArray.
+	// Only JSContext, JSObject and JSArrayBuilder can create a JSArray.
 	friend JSContext;
 	friend JSObject;
+	friend class JSArrayBuilder;
 	
 	JSArray(const JSContext& js_context, const std::vector<JSValue>& arguments = {});
 
 	static JSObjectRef MakeArray(const JSContext& js_context, const std::vector<JSValue>& arguments);
 
+	// Create an Array from the elements of a typed array by calling
+	// the built-in Array.prototype.slice once.
+	static JSArray MakeArrayFromTypedArray(const JSObject& typed_array);
+
+	// Copy this array's elements, converted by ToNumber, into a
+	// Float64Array with the built-in %TypedArray%.prototype.set.
+	std::vector<double> CopyToFloat64() const;
+
+	// Like CopyToFloat64 but throws std::invalid_argument at the first
+	// hole or non-number.
+	std::vector<double> CopyNumbersToFloat64() const;
+
 	// For interoperability with the JavaScriptCore C API.
 	JSArray(const JSContext& js_context, JSObjectRef js_object_ref);
+
+	// Store the private data of count elements starting at first_index
+	// into private_data, or nullptr for elements that are not objects
+	// of js_class.
+	void GetPrivateData(const JSClass& js_class, uint32_t first_index, void* private_data[], std::size_t count) const;
 };
 
 template<typename T>
@@ -133,6 +297,35 @@ std::vector<std::shared_ptr<T>> JSArray::GetPrivateItems() const HAL_NOEXCEPT {
 	return items;
 }
 
+template<typename T>
+std::vector<T*> JSArray::GetPrivatePointers() const {
+	std::vector<T*> items(GetLength());
+	GetPrivatePointers(items.data(), items.size());
+	return items;
+}
+
+template<typename T>
+std::size_t JSArray::GetPrivatePointers(T* items[], std::size_t count) const {
+	static_assert(std::is_base_of<JSExportObject, T>::value, "T must be derived from JSExportObject");
+	const JSClass& js_class = JSExport<T>::Class();
+	const auto length = std::min<std::size_t>(count, GetLength());
+
+	// Work through a small stack buffer so that filling items never
+	// allocates.
+	void* private_data[64];
+	for (std::size_t first_index = 0; first_index < length; first_index += 64) {
+		const auto chunk_size = std::min<std::size_t>(64, length - first_index);
+		GetPrivateData(js_class, static_cast<uint32_t>(first_index), private_data, chunk_size);
+		for (std::size_t i = 0; i < chunk_size; ++i) {
+			// JSExportClass stores the T* of the most derived class, and
+			// JSExportObject is always its first base.
+			items[first_index + i] = static_cast<T*>(static_cast<JSExportObject*>(private_data[i]));
+		}
+	}
+
+	return length;
+}
+
 } // namespace HAL {
 
 #endif // _HAL_JSARRAY_HPP_
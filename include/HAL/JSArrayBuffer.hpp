@@ -0,0 +1,91 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSARRAYBUFFER_HPP_
+#define _HAL_JSARRAYBUFFER_HPP_
+
+#include "HAL/JSObject.hpp"
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <string>
+
+namespace HAL {
+
+/*!
+  @class
+
+  @discussion A JavaScript object of the ArrayBuffer type.
+
+  The bytes of a JSArrayBuffer are accessed in place through data()
+  and size(), so no copy is made when native code reads or writes
+  them.
+
+  A JSArrayBuffer may also wrap memory that native code owns, such as
+  a decoded image or a memory-mapped file. In that case JavaScript
+  reads and writes the native memory directly, and the native owner is
+  released when the garbage collector finalizes the ArrayBuffer.
+
+  The only way to create a JSArrayBuffer is by using the
+  JSContext::CreateArrayBuffer family of member functions or by
+  converting a JSObject that is an ArrayBuffer.
+*/
+class HAL_EXPORT JSArrayBuffer final : public JSObject HAL_PERFORMANCE_COUNTER2(JSArrayBuffer) {
+
+public:
+
+	/*!
+	 @method
+
+	 @abstract Return a pointer to the bytes of this ArrayBuffer.
+
+	 @discussion The pointer is valid for as long as this ArrayBuffer
+	 is alive.
+
+	 @result A pointer to the first byte of this ArrayBuffer.
+	 */
+	void* data() const;
+
+	/*!
+	 @method
+
+	 @abstract Return the number of bytes in this ArrayBuffer.
+
+	 @result The number of bytes in this ArrayBuffer.
+	 */
+	std::size_t size() const;
+
+private:
+
+	// Only JSContext and JSObject can create a JSArrayBuffer.
+	friend JSContext;
+	friend JSObject;
+
+	// JSTypedArray::GetArrayBuffer returns its backing store.
+	template<typename T>
+	friend class JSTypedArray;
+
+	JSArrayBuffer(const JSContext& js_context, std::size_t byte_length);
+	JSArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator);
+
+	static JSObjectRef MakeArrayBuffer(const JSContext& js_context, std::size_t byte_length);
+	static JSObjectRef MakeArrayBufferWithBytesNoCopy(const JSContext& js_context, void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator);
+	static JSArrayBuffer MapFile(const JSContext& js_context, const std::string& path);
+
+	// The JSTypedArrayBytesDeallocator that JavaScriptCore calls when
+	// an externally owned ArrayBuffer is finalized.
+	static void JSTypedArrayBytesDeallocatorCallback(void* bytes, void* deallocator_context);
+
+	// For interoperability with the JavaScriptCore C API.
+	JSArrayBuffer(const JSContext& js_context, JSObjectRef js_object_ref);
+};
+
+} // namespace HAL {
+
+#endif // _HAL_JSARRAYBUFFER_HPP_
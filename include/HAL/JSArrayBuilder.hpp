@@ -0,0 +1,139 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSARRAYBUILDER_HPP_
+#define _HAL_JSARRAYBUILDER_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSArray.hpp"
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+namespace HAL {
+
+  class JSString;
+  class JSValue;
+  class JSObject;
+
+  /*!
+   @class
+
+   @discussion A JSArrayBuilder accumulates the elements of a
+   JavaScript Array and creates it with a single call to
+   JSObjectMakeArray.
+
+   Native numbers, booleans and strings are appended as raw
+   JavaScriptCore values without creating a JSValue wrapper for each
+   one. Appended values are kept alive by the builder until Build is
+   called or the builder is destroyed.
+
+   A JSArrayBuilder is not thread safe and can't be copied.
+   */
+  class HAL_EXPORT JSArrayBuilder final HAL_PERFORMANCE_COUNTER1(JSArrayBuilder) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create an empty builder for a JavaScript Array in the
+     given execution context.
+
+     @param js_context The execution context of the Array.
+
+     @param capacity The number of elements to reserve space for.
+     */
+    explicit JSArrayBuilder(const JSContext& js_context, std::size_t capacity = 0);
+
+    /*!
+     @method
+
+     @abstract Reserve space for at least capacity elements.
+     */
+    void Reserve(std::size_t capacity);
+
+    /*!
+     @method
+
+     @abstract Append an element to the Array being built.
+
+     @result This builder, so that calls may be chained.
+     */
+    JSArrayBuilder& AppendUndefined();
+    JSArrayBuilder& AppendNull();
+    JSArrayBuilder& AppendBoolean(bool boolean);
+    JSArrayBuilder& AppendNumber(double number);
+    JSArrayBuilder& AppendString(const char* string);
+    JSArrayBuilder& AppendString(const std::string& string);
+    JSArrayBuilder& AppendString(const JSString& string);
+    JSArrayBuilder& Append(const JSValue& js_value);
+    JSArrayBuilder& Append(const JSObject& js_object);
+
+    /*!
+     @method
+
+     @abstract Return the number of elements appended so far.
+     */
+    std::size_t GetLength() const HAL_NOEXCEPT {
+      return js_value_refs__.size();
+    }
+
+    /*!
+     @method
+
+     @abstract Create a JavaScript Array from the appended elements
+     and reset this builder so that it may be reused.
+
+     @result A JavaScript object that is an Array.
+
+     @throws std::runtime_error if JavaScriptCore could not create the
+     Array.
+     */
+    JSArray Build();
+
+    ~JSArrayBuilder()                                   HAL_NOEXCEPT;
+    JSArrayBuilder(JSArrayBuilder&&)                    HAL_NOEXCEPT;
+    JSArrayBuilder& operator=(JSArrayBuilder&&)         HAL_NOEXCEPT;
+    void swap(JSArrayBuilder&)                          HAL_NOEXCEPT;
+
+    JSArrayBuilder(const JSArrayBuilder&)               = delete;
+    JSArrayBuilder& operator=(const JSArrayBuilder&)    = delete;
+
+  private:
+
+    // JSObjectTemplate appends the objects it creates without a
+    // JSObject wrapper.
+    friend class JSObjectTemplate;
+
+    JSArrayBuilder& AppendJSValueRef(JSValueRef js_value_ref);
+    void Clear() HAL_NOEXCEPT;
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    JSContext               js_context__;
+
+    // Each JSValueRef in this vector is protected with JSValueProtect
+    // because the garbage collector does not scan the heap memory of
+    // a std::vector.
+    std::vector<JSValueRef> js_value_refs__;
+#pragma warning(pop)
+  };
+
+  inline
+  void swap(JSArrayBuilder& first, JSArrayBuilder& second) HAL_NOEXCEPT {
+    first.swap(second);
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSARRAYBUILDER_HPP_
@@ -0,0 +1,173 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSCALLBATCHER_HPP_
+#define _HAL_JSCALLBATCHER_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/JSArrayBuilder.hpp"
+
+#include <chrono>
+#include <cstddef>
+#include <vector>
+
+namespace HAL {
+
+  class JSValue;
+
+  /*!
+   @class
+
+   @discussion A JSCallBatcher queues calls from native code into
+   JavaScript and delivers them with a single call into the context,
+   so that many small notifications, such as property changes or
+   input events, cross the native to JavaScript boundary once per
+   batch instead of once per notification.
+
+   A JSCallBatcher works in one of two ways, chosen when it is
+   created:
+
+   1. Given a callback, each Enqueue(event) appends an event and a
+   flush calls the callback once with an Array of the queued events.
+
+   2. Without a callback, each Enqueue(callable, arguments) queues a
+   call and a flush runs a JavaScript loop that makes all of the
+   queued calls in order. A call that throws does not stop the others;
+   the first exception is rethrown once the loop is done.
+
+   The queue is flushed by an explicit call to Flush, when it reaches
+   max_batch_size calls, or when an Enqueue or FlushIfDue happens at
+   least max_delay after the oldest queued call. A max_batch_size or
+   max_delay of zero disables that policy. HAL has no run loop of its
+   own, so a host that wants time based flushing without further
+   Enqueues calls FlushIfDue from its own timer.
+
+   Queued values are kept alive by the batcher. Calls that are still
+   queued when the batcher is destroyed are discarded, so call Flush
+   first if they matter.
+
+   A JSCallBatcher is not thread safe and can't be copied.
+   */
+  class HAL_EXPORT JSCallBatcher final HAL_PERFORMANCE_COUNTER1(JSCallBatcher) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a batcher whose flushes call callback once with
+     an Array of the queued events.
+
+     @throws std::invalid_argument if callback is not a function.
+     */
+    JSCallBatcher(const JSContext& js_context, const JSObject& callback, std::size_t max_batch_size = 0, std::chrono::milliseconds max_delay = std::chrono::milliseconds::zero());
+
+    /*!
+     @method
+
+     @abstract Create a batcher whose flushes make each queued call
+     from a single JavaScript loop.
+     */
+    explicit JSCallBatcher(const JSContext& js_context, std::size_t max_batch_size = 0, std::chrono::milliseconds max_delay = std::chrono::milliseconds::zero());
+
+    /*!
+     @method
+
+     @abstract Queue an event for the batcher's callback.
+
+     @throws std::invalid_argument if this batcher was created without
+     a callback.
+
+     @throws std::runtime_error if the queue was flushed and the
+     callback threw a JavaScript exception.
+     */
+    void Enqueue(const JSValue& event);
+
+    /*!
+     @method
+
+     @abstract Queue a call of callable with the given arguments and
+     an undefined 'this'.
+
+     @throws std::invalid_argument if this batcher was created with a
+     callback, or if callable is not a function.
+
+     @throws std::runtime_error if the queue was flushed and a queued
+     call threw a JavaScript exception.
+     */
+    void Enqueue(const JSObject& callable, const std::vector<JSValue>& arguments = std::vector<JSValue>());
+
+    /*!
+     @method
+
+     @abstract Deliver the queued calls, if any, with a single call
+     into JavaScript.
+
+     @discussion The queue is emptied before the call, so calls queued
+     by JavaScript during the flush are delivered by the next one.
+
+     @throws std::runtime_error if a delivered call threw a JavaScript
+     exception.
+     */
+    void Flush();
+
+    /*!
+     @method
+
+     @abstract Flush the queue if its oldest call has waited at least
+     max_delay.
+
+     @result true if the queue was flushed.
+     */
+    bool FlushIfDue();
+
+    /*!
+     @method
+
+     @abstract Return the number of queued calls.
+     */
+    std::size_t GetPendingCount() const HAL_NOEXCEPT {
+      return pending_count__;
+    }
+
+    ~JSCallBatcher()                                 HAL_NOEXCEPT;
+    JSCallBatcher(const JSCallBatcher&)              = delete;
+    JSCallBatcher& operator=(const JSCallBatcher&)   = delete;
+
+  private:
+
+    typedef std::chrono::steady_clock Clock;
+
+    static JSObject MakeDrainFunction(const JSContext& js_context);
+
+    void Enqueued();
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    JSContext                 js_context__;
+
+    // Either the user's callback or the drain loop.
+    JSObject                  function__;
+    bool                      coalesce__;
+    std::size_t               max_batch_size__;
+    std::chrono::milliseconds max_delay__;
+
+    // The events, or callable and arguments pairs, of the next batch.
+    JSArrayBuilder            pending__;
+    std::size_t               pending_count__ { 0 };
+    Clock::time_point         oldest_enqueue_time__;
+#pragma warning(pop)
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSCALLBATCHER_HPP_
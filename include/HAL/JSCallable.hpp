@@ -0,0 +1,200 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSCALLABLE_HPP_
+#define _HAL_JSCALLABLE_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSCallable is a prepared handle to a JavaScript
+   function that native code invokes repeatedly, such as a render
+   callback or a reducer.
+
+   The function and its receiver are validated and pinned once when
+   the JSCallable is created. Each call then goes straight to
+   JSObjectCallAsFunction using the cached JSContextRef, JSObjectRefs
+   and a reusable argument buffer, so no JSObject wrappers or argument
+   vectors are built per call.
+
+   A JSCallable is not thread safe: like the JSContext it belongs to,
+   it must only be invoked from one thread at a time.
+   */
+  class HAL_EXPORT JSCallable final HAL_PERFORMANCE_COUNTER1(JSCallable) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Prepare a JavaScript function for repeated invocation
+     using the global object as 'this'.
+
+     @param function The JavaScript function to invoke.
+
+     @throws std::runtime_error if function can't be called as a
+     function.
+     */
+    explicit JSCallable(const JSObject& function);
+
+    /*!
+     @method
+
+     @abstract Prepare a JavaScript function for repeated invocation
+     with a fixed 'this' object.
+
+     @param function The JavaScript function to invoke.
+
+     @param this_object The JavaScript object to use as 'this' on
+     every invocation.
+
+     @throws std::runtime_error if function can't be called as a
+     function.
+     */
+    JSCallable(const JSObject& function, const JSObject& this_object);
+
+    /*!
+     @method
+
+     @abstract Invoke the prepared function.
+
+     @param arguments Optional JSValue argument(s) to pass to the
+     function.
+
+     @result Return the function's return value.
+
+     @throws std::runtime_error if calling the function threw a
+     JavaScript exception.
+     */
+    JSValue Invoke();
+    JSValue Invoke(const JSValue& argument);
+    JSValue Invoke(const std::vector<JSValue>& arguments);
+
+    /*!
+     @method
+
+     @abstract Invoke the prepared function with any number of JSValue
+     or JSObject arguments without building an intermediate
+     std::vector<JSValue>.
+
+     @result Return the function's return value.
+
+     @throws std::runtime_error if calling the function threw a
+     JavaScript exception.
+     */
+    template<typename... Args>
+    JSValue operator()(const Args&... arguments) {
+      arguments__.clear();
+      using expander = int[];
+      static_cast<void>(expander{0, (arguments__.push_back(ToJSValueRef(arguments)), 0)...});
+      return InvokeWithArgumentBuffer();
+    }
+
+    /*!
+     @method
+
+     @abstract Invoke the prepared function with raw JavaScriptCore
+     values. For interoperability with the JavaScriptCore C API.
+
+     @param argument_count The number of values in arguments.
+
+     @param arguments The values to pass to the function.
+
+     @result Return the function's return value.
+
+     @throws std::runtime_error if calling the function threw a
+     JavaScript exception.
+     */
+    JSValue Invoke(std::size_t argument_count, const JSValueRef arguments[]);
+
+    /*!
+     @method
+
+     @abstract Return the prepared JavaScript function.
+
+     @result The prepared JavaScript function.
+     */
+    JSObject get_function() const HAL_NOEXCEPT {
+      return function__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the JavaScript object used as 'this'.
+
+     @result The JavaScript object used as 'this'.
+     */
+    JSObject get_this_object() const HAL_NOEXCEPT {
+      return this_object__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the execution context of the prepared function.
+
+     @result The execution context of the prepared function.
+     */
+    JSContext get_context() const HAL_NOEXCEPT {
+      return js_context__;
+    }
+
+    ~JSCallable()                               HAL_NOEXCEPT;
+    JSCallable(const JSCallable&)               HAL_NOEXCEPT;
+    JSCallable(JSCallable&&)                    HAL_NOEXCEPT;
+    JSCallable& operator=(JSCallable)           HAL_NOEXCEPT;
+    void swap(JSCallable&)                      HAL_NOEXCEPT;
+
+  private:
+
+    JSValue InvokeWithArgumentBuffer();
+
+    static JSValueRef ToJSValueRef(const JSValue& js_value) HAL_NOEXCEPT {
+      return static_cast<JSValueRef>(js_value);
+    }
+
+    static JSValueRef ToJSValueRef(const JSObject& js_object) HAL_NOEXCEPT {
+      return static_cast<JSObjectRef>(js_object);
+    }
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    JSContext               js_context__;
+
+    // These JSObjects keep the function and its receiver protected
+    // from garbage collection for the lifetime of this JSCallable.
+    JSObject                function__;
+    JSObject                this_object__;
+
+    JSContextRef            js_context_ref__     { nullptr };
+    JSObjectRef             function_ref__       { nullptr };
+    JSObjectRef             this_object_ref__    { nullptr };
+    std::vector<JSValueRef> arguments__;
+#pragma warning(pop)
+  };
+
+  inline
+  void swap(JSCallable& first, JSCallable& second) HAL_NOEXCEPT {
+    first.swap(second);
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSCALLABLE_HPP_
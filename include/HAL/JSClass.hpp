@@ -52,6 +52,10 @@ namespace HAL {
      
      @abstract Return an empty JSClass.
      
+     @discussion All empty JSClasses share a single JSClassRef that is
+     created once per process, so constructing one does not call
+     JSClassCreate.
+     
      @result An empty JSClass.
      */
     JSClass() HAL_NOEXCEPT;
@@ -84,10 +88,11 @@ namespace HAL {
     
   private:
     
-    // These five classes need access to operator JSClassRef().
+    // These classes need access to operator JSClassRef().
     friend class JSContext; // for constructor
     friend class JSValue;   // for IsObjectOfClass
     friend class JSObject;  // for constructor
+    friend class JSArray;   // for GetPrivatePointers
     
     // For setting JSClassDefinition.parentClass
     template<typename T>
@@ -101,6 +106,8 @@ namespace HAL {
       return js_class_ref__;
     }
     
+    static JSClassRef EmptyJSClassRef() HAL_NOEXCEPT;
+    
     // Silence 4251 on Windows since private member variables do not
     // need to be exported from a DLL.
 #pragma warning(push)
@@ -14,6 +14,10 @@
 
 #include <vector>
 #include <unordered_map>
+#include <functional>
+#include <memory>
+#include <string>
+#include <utility>
 
 namespace HAL {
   
@@ -26,11 +30,21 @@ namespace HAL {
   class JSNumber;
   class JSObject;
   class JSArray;
+  class JSArrayBuffer;
   class JSDate;
   class JSError;
   class JSRegExp;
   class JSFunction;
+  class JSArguments;
+  class JSPromiseResolver;
   class JSExportObject;
+  class JSDocumentNode;
+  
+  template<typename T>
+  class JSTypedArray;
+  
+  template<typename T>
+  class JSExpected;
   
   namespace detail {
     template<typename T>
@@ -42,6 +56,7 @@ namespace HAL {
 namespace HAL {
 
   typedef std::function<JSValue(const std::vector<JSValue>, JSObject&)> JSFunctionCallback;
+  typedef std::function<JSValue(const JSArguments&, JSObject&)>        JSArgumentsCallback;
   
   /*!
    @class
@@ -234,6 +249,226 @@ namespace HAL {
     JSArray CreateArray() const HAL_NOEXCEPT;
     JSArray CreateArray(const std::vector<JSValue>& arguments) const;
     
+    /*!
+     @method
+     
+     @abstract Create a JavaScript Array of numbers from native values
+     in one bulk operation.
+     
+     @discussion The values are copied into a typed array with a
+     single memcpy and then into a new Array by one call to the
+     built-in Array.prototype.slice, so no per-element JSValue is
+     created on the native side.
+     
+     @param values The native values to populate the array.
+     
+     @result A JavaScript object that is an Array of numbers.
+     */
+    JSArray CreateArrayFromNumbers(const std::vector<double>& values) const;
+    JSArray CreateArrayFromNumbers(const std::vector<int32_t>& values) const;
+    JSArray CreateArrayFromNumbers(const std::vector<uint32_t>& values) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer object.
+     
+     @param byte_length The number of bytes in the ArrayBuffer.
+     
+     @param bytes Optional bytes to copy into the ArrayBuffer.
+     Otherwise the ArrayBuffer is zero-filled.
+     
+     @result A JavaScript object that is an ArrayBuffer.
+     */
+    JSArrayBuffer CreateArrayBuffer(std::size_t byte_length) const;
+    JSArrayBuffer CreateArrayBuffer(const void* bytes, std::size_t byte_length) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer that uses native memory
+     as its backing store without copying it.
+     
+     @discussion JavaScript reads and writes bytes in place, so bytes
+     must stay valid until the deallocator is called. The deallocator
+     is called exactly once, when the garbage collector finalizes the
+     ArrayBuffer, or immediately if the ArrayBuffer can't be created.
+     
+     @param bytes The native memory to expose to JavaScript.
+     
+     @param byte_length The number of bytes to expose.
+     
+     @param deallocator Called with bytes when JavaScript no longer
+     references the ArrayBuffer.
+     
+     @param owner Alternatively, a native object that owns bytes. A
+     reference to owner is held until the ArrayBuffer is finalized.
+     
+     @result A JavaScript object that is an ArrayBuffer.
+     */
+    JSArrayBuffer CreateArrayBufferWithBytesNoCopy(void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator) const;
+    JSArrayBuffer CreateArrayBufferWithBytesNoCopy(void* bytes, std::size_t byte_length, const std::shared_ptr<void>& owner) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript ArrayBuffer backed by a memory
+     mapping of a file.
+     
+     @discussion The file is opened read-only and mapped
+     copy-on-write, so pages are loaded on demand and shared with the
+     page cache. Writes made by JavaScript stay private to the
+     ArrayBuffer and never reach the file. The mapping is released
+     when the ArrayBuffer is finalized.
+     
+     @param path The path of the file to map.
+     
+     @result A JavaScript object that is an ArrayBuffer with the
+     contents of the file.
+     
+     @throws std::runtime_error if the file can't be opened or
+     mapped.
+     */
+    JSArrayBuffer CreateArrayBufferFromFile(const std::string& path) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript typed array whose elements are of
+     the native type T, e.g. CreateTypedArray<float> creates a
+     Float32Array. Include HAL/JSTypedArray.hpp to use this method.
+     
+     @discussion When created from native values the elements are
+     copied with a single memcpy rather than one property at a time.
+     
+     @param length The number of elements in the typed array.
+     
+     @param values Optional native values to copy into the typed
+     array. Otherwise the typed array is zero-filled.
+     
+     @result A JavaScript object that is a typed array.
+     */
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(std::size_t length) const;
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(const T* values, std::size_t length) const;
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(const std::vector<T>& values) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript typed array that is a view onto
+     an existing ArrayBuffer. No bytes are copied.
+     
+     @param array_buffer The ArrayBuffer to view.
+     
+     @param byte_offset The offset in bytes of the first element.
+     
+     @param length The number of elements in the typed array.
+     
+     @result A JavaScript object that is a typed array sharing the
+     bytes of array_buffer.
+     */
+    template<typename T>
+    JSTypedArray<T> CreateTypedArray(const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length) const;
+    
+    /*!
+     @method
+     
+     @abstract Expose a native std::vector<T> to JavaScript as an
+     array-like object without copying it. Include
+     HAL/JSNativeArray.hpp to use this method.
+     
+     @discussion Indexed reads and writes and 'length' go straight to
+     the native vector, and the generic Array.prototype methods work
+     on the returned object. The vector is kept alive until the
+     object is garbage collected.
+     
+     @param storage The native vector to expose.
+     
+     @result A JavaScript object backed by storage.
+     
+     @throws std::invalid_argument if storage is null.
+     */
+    template<typename T>
+    JSObject CreateNativeArray(const std::shared_ptr<std::vector<T>>& storage) const;
+    
+    /*!
+     @method
+     
+     @abstract Expose a native document tree to JavaScript through a
+     read-only proxy that converts properties only when they are read.
+     
+     @discussion See JSDocumentNode for the interface the tree
+     implements. Include HAL/JSDocumentProxy.hpp to implement it.
+     
+     @param root The root node of the document.
+     
+     @param cache_children Whether a child proxy is created once and
+     kept by its parent, so that repeated reads return the same object,
+     or created anew on every read.
+     
+     @result A JavaScript object that is a proxy for root.
+     
+     @throws std::invalid_argument if root is null.
+     */
+    JSObject CreateDocumentProxy(const std::shared_ptr<JSDocumentNode>& root, bool cache_children = true) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript iterator whose values are pulled
+     lazily from native code, for use with for...of, spread and
+     Array.from. Include HAL/JSNativeIterator.hpp to iterate a native
+     range.
+     
+     @discussion source stores the next value and returns true, or
+     returns false when there are no more values.
+     
+     A native range [first, last) is iterated by converting each
+     element with converter, which returns a JSValue. The iterators
+     are copied into the JavaScript iterator and must stay valid for
+     as long as it is used.
+     
+     @result A JavaScript object that is an iterable iterator.
+     */
+    JSObject CreateIterator(const std::function<bool(JSValue& value)>& source) const;
+    
+    template<typename Iterator, typename Converter>
+    JSObject CreateIterator(Iterator first, Iterator last, Converter converter) const;
+    
+    /*!
+     @method
+     
+     @abstract Create a JavaScript object with on, once, off,
+     removeAllListeners, listenerCount and emit functions whose
+     listeners are kept natively. Include HAL/JSEventEmitter.hpp to
+     emit events from native code.
+     
+     @result A JavaScript object whose private data is a
+     JSEventEmitter.
+     */
+    JSObject CreateEventEmitter() const;
+    
+    /*!
+     @method
+     
+     @abstract Create a pending JavaScript Promise and the resolver
+     that settles it, as if by JavaScriptCore's
+     JSObjectMakeDeferredPromise. Include HAL/JSPromise.hpp to use the
+     resolver.
+     
+     @discussion Return the promise to the script right away and keep
+     the resolver until the native work is done.
+     
+     @result The promise and its resolver.
+     
+     @throws std::runtime_error if JavaScriptCore could not create the
+     promise.
+     */
+    std::pair<JSObject, JSPromiseResolver> CreatePromise() const;
+    
     /*!
      @method
      
@@ -333,6 +568,57 @@ namespace HAL {
     JSFunction CreateFunction(JSFunctionCallback& callback) const;
     JSFunction CreateFunction(const JSString& function_name, JSFunctionCallback& callback) const;
 
+    /*!
+     @method
+
+     @abstract Create a JavaScript function whose callback is given a
+     JSArguments view of its arguments instead of a
+     std::vector<JSValue>.
+
+     @discussion A JSArguments neither allocates nor protects the
+     arguments, so this is the cheaper form for small functions that
+     only read a few numbers or strings from their arguments. A C++
+     exception thrown by the callback is rethrown in JavaScript as an
+     Error.
+
+     @param function_name A JSString containing the function's name.
+     An empty string creates an anonymous function.
+
+     @param callback The callback to invoke when the function is
+     called.
+
+     @result A JSObject that is a function. The object's prototype
+     will be the default function prototype.
+     */
+    JSFunction CreateFunction(const JSString& function_name, const JSArgumentsCallback& callback) const;
+
+    /*!
+     @method
+     
+     @abstract Create a JavaScript function implemented by a native
+     callable with the given signature, e.g.
+     CreateFunction<double(double, double)>("add", std::plus<double>()).
+     
+     @discussion Arguments are converted straight from JavaScriptCore
+     values to the native parameter types, and the result straight
+     back, without a std::vector<JSValue>. Parameters and results may
+     be arithmetic types, bool, std::string, JSValue or JSObject, and
+     the result may also be void.
+     
+     Calling the function with fewer arguments than parameters, or
+     with an argument of the wrong type, throws a JavaScript TypeError
+     without calling callable. A C++ exception thrown by callable is
+     rethrown in JavaScript as an Error.
+     
+     @result A JavaScript function whose prototype is the default
+     function prototype.
+     */
+    template<typename Signature, typename Callable>
+    JSFunction CreateFunction(Callable callable) const;
+    
+    template<typename Signature, typename Callable>
+    JSFunction CreateFunction(const JSString& function_name, Callable callable) const;
+
     /*!
      @method
      
@@ -377,6 +663,22 @@ namespace HAL {
     JSValue JSEvaluateScript(const JSString& script,                       const JSString& source_url, int starting_line_number = 1) const;
     JSValue JSEvaluateScript(const JSString& script, JSObject this_object, const JSString& source_url, int starting_line_number = 1) const;
     
+    /*!
+     @method
+     
+     @abstract Evaluate a string of JavaScript code without throwing.
+     
+     @discussion This is JSEvaluateScript for scripts that are
+     expected to throw. An exception thrown by the script is returned
+     as is, without being thrown or logged.
+     
+     @result The JSValue that results from evaluating script, or the
+     exception that the script threw.
+     */
+    JSExpected<JSValue> TryEvaluateScript(const JSString& script                                                                                ) const;
+    JSExpected<JSValue> TryEvaluateScript(const JSString& script, JSObject this_object                                                          ) const;
+    JSExpected<JSValue> TryEvaluateScript(const JSString& script, JSObject this_object, const JSString& source_url, int starting_line_number = 1) const;
+    
     /*!
      @method
      
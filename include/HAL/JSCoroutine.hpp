@@ -0,0 +1,341 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSCOROUTINE_HPP_
+#define _HAL_JSCOROUTINE_HPP_
+
+#include "HAL/JSPromise.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+// The rest of HAL is C++11. This header is only compiled by C++20
+// compilers with coroutine support, so it can be included
+// unconditionally.
+#if defined(__cpp_impl_coroutine) && __cpp_impl_coroutine >= 201902L && defined(__has_include)
+#if __has_include(<coroutine>)
+#define HAL_HAS_COROUTINES 1
+#endif
+#endif
+
+#ifdef HAL_HAS_COROUTINES
+
+#include <coroutine>
+#include <exception>
+#include <string>
+#include <utility>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion The awaiter returned by JSAwait, which suspends a
+   native coroutine until a JavaScript promise settles.
+
+   Awaiting calls the promise's then function once with two native
+   functions that point back at the awaiter in the coroutine frame,
+   so no C++ heap memory is allocated per co_await. The coroutine is
+   resumed from the promise reaction, on the thread that runs the
+   context's scripts.
+
+   Awaiting a value that is not a thenable gives the value itself, as
+   in JavaScript. A rejection is rethrown by co_await as a
+   std::runtime_error, or as a js_runtime_error if the reason is an
+   Error.
+   */
+  class JSPromiseAwaiter final HAL_PERFORMANCE_COUNTER1(JSPromiseAwaiter) {
+
+  public:
+
+    JSPromiseAwaiter(const JSContext& js_context, JSValueRef value_ref) HAL_NOEXCEPT
+    : js_context__(js_context)
+    , value_ref__(value_ref) {
+      JSValueProtect(static_cast<JSContextRef>(js_context__), value_ref__);
+    }
+
+    ~JSPromiseAwaiter() HAL_NOEXCEPT {
+      const auto context_ref = static_cast<JSContextRef>(js_context__);
+      // If the coroutine was destroyed while it was suspended, the
+      // reactions must no longer point at this awaiter.
+      ReleaseReactions();
+      JSValueUnprotect(context_ref, value_ref__);
+    }
+
+    JSPromiseAwaiter(const JSPromiseAwaiter&)            = delete;
+    JSPromiseAwaiter& operator=(const JSPromiseAwaiter&) = delete;
+
+    bool await_ready() const HAL_NOEXCEPT {
+      return !JSValueIsObject(static_cast<JSContextRef>(js_context__), value_ref__);
+    }
+
+    bool await_suspend(std::coroutine_handle<> handle) {
+      static const JSStringRef then_name_ref = JSStringCreateWithUTF8CString("then");
+      const auto context_ref = static_cast<JSContextRef>(js_context__);
+      const auto object_ref  = JSValueToObject(context_ref, value_ref__, nullptr);
+
+      JSValueRef exception { nullptr };
+      const auto then_ref = JSObjectGetProperty(context_ref, object_ref, then_name_ref, &exception);
+      if (exception) {
+        SetValue(exception, true);
+        return false;
+      }
+      if (!JSValueIsObject(context_ref, then_ref) || !JSObjectIsFunction(context_ref, JSValueToObject(context_ref, then_ref, nullptr))) {
+        return false;
+      }
+
+      handle__             = handle;
+      fulfilled_ref__      = JSObjectMake(context_ref, ReactionClass(), this);
+      JSValueProtect(context_ref, fulfilled_ref__);
+      rejected_ref__       = JSObjectMake(context_ref, ReactionClass(), this);
+      JSValueProtect(context_ref, rejected_ref__);
+
+      const JSValueRef arguments[] = { fulfilled_ref__, rejected_ref__ };
+      JSObjectCallAsFunction(context_ref, JSValueToObject(context_ref, then_ref, nullptr), object_ref, 2, arguments, &exception);
+      if (exception) {
+        ReleaseReactions();
+        SetValue(exception, true);
+        return false;
+      }
+      return true;
+    }
+
+    JSValue await_resume() const {
+      if (rejected__) {
+        detail::ThrowRuntimeError("JSAwait", JSValue(js_context__, value_ref__));
+      }
+      return JSValue(js_context__, value_ref__);
+    }
+
+  private:
+
+    static JSClassRef ReactionClass() HAL_NOEXCEPT {
+      // The awaiter owns the reactions' private data.
+      static const JSClassRef js_class_ref = detail::CreateFunctionClass(ReactionCallback);
+      return js_class_ref;
+    }
+
+    static JSValueRef ReactionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef, size_t argument_count, const JSValueRef arguments_array[], JSValueRef*) {
+      const auto awaiter_ptr = static_cast<JSPromiseAwaiter*>(JSObjectGetPrivate(function_ref));
+      if (awaiter_ptr) {
+        const bool rejected = function_ref == awaiter_ptr->rejected_ref__;
+        awaiter_ptr->SetValue(argument_count > 0 ? arguments_array[0] : JSValueMakeUndefined(context_ref), rejected);
+        const auto handle = awaiter_ptr->handle__;
+        awaiter_ptr->ReleaseReactions();
+        // The coroutine may finish, and destroy the awaiter, before
+        // resume returns.
+        handle.resume();
+      }
+      return JSValueMakeUndefined(context_ref);
+    }
+
+    void SetValue(JSValueRef value_ref, bool rejected) HAL_NOEXCEPT {
+      const auto context_ref = static_cast<JSContextRef>(js_context__);
+      JSValueProtect(context_ref, value_ref);
+      JSValueUnprotect(context_ref, value_ref__);
+      value_ref__ = value_ref;
+      rejected__  = rejected;
+    }
+
+    void ReleaseReactions() HAL_NOEXCEPT {
+      if (!fulfilled_ref__) {
+        return;
+      }
+      const auto context_ref = static_cast<JSContextRef>(js_context__);
+      JSObjectSetPrivate(fulfilled_ref__, nullptr);
+      JSObjectSetPrivate(rejected_ref__, nullptr);
+      JSValueUnprotect(context_ref, fulfilled_ref__);
+      JSValueUnprotect(context_ref, rejected_ref__);
+      fulfilled_ref__ = nullptr;
+      rejected_ref__  = nullptr;
+    }
+
+    JSContext               js_context__;
+    JSValueRef              value_ref__;
+    bool                    rejected__      { false };
+    std::coroutine_handle<> handle__;
+    JSObjectRef             fulfilled_ref__ { nullptr };
+    JSObjectRef             rejected_ref__  { nullptr };
+  };
+
+  /*!
+   @function
+
+   @abstract Return an awaiter that suspends a native coroutine until
+   a JavaScript promise, or any thenable, settles.
+
+   @discussion For example:
+
+   JSTask Fetch(const JSContext& js_context, JSObject fetch) {
+     const JSValue response = co_await JSAwait(fetch(js_context.get_global_object()));
+     co_return response;
+   }
+   */
+  inline JSPromiseAwaiter JSAwait(const JSValue& js_value) HAL_NOEXCEPT {
+    return JSPromiseAwaiter(js_value.get_context(), static_cast<JSValueRef>(js_value));
+  }
+
+  inline JSPromiseAwaiter JSAwait(const JSObject& js_object) HAL_NOEXCEPT {
+    return JSPromiseAwaiter(js_object.get_context(), static_cast<JSObjectRef>(js_object));
+  }
+
+  namespace detail {
+
+    /*!
+     @class
+
+     @discussion The part of the promise_type of a JSTask or
+     JSVoidTask that does not depend on how the coroutine returns.
+     */
+    template<typename Task>
+    class JSTaskPromise HAL_PERFORMANCE_COUNTER1(JSTaskPromise) {
+
+    public:
+
+      template<typename... Args>
+      JSTaskPromise(const JSContext& js_context, Args&&...)
+      : deferred__(js_context.CreatePromise()) {
+      }
+
+      template<typename Self, typename... Args>
+      JSTaskPromise(Self&&, const JSContext& js_context, Args&&...)
+      : deferred__(js_context.CreatePromise()) {
+      }
+
+      Task get_return_object() const HAL_NOEXCEPT {
+        return Task(deferred__.first);
+      }
+
+      std::suspend_never initial_suspend() const HAL_NOEXCEPT {
+        return std::suspend_never();
+      }
+
+      std::suspend_never final_suspend() const noexcept {
+        return std::suspend_never();
+      }
+
+      void unhandled_exception() {
+        try {
+          throw;
+        } catch (const std::exception& e) {
+          deferred__.second.Reject(std::string(e.what()));
+        } catch (...) {
+          deferred__.second.Reject(std::string("unknown exception"));
+        }
+      }
+
+    protected:
+
+      std::pair<JSObject, JSPromiseResolver> deferred__;
+    };
+
+  } // namespace detail {
+
+  /*!
+   @class
+
+   @discussion The return type of a native coroutine that is exposed
+   to JavaScript as a promise.
+
+   The coroutine's first parameter, or its first after the object of
+   a member function, must be the JSContext of the promise. It runs
+   eagerly until its first co_await, like a JavaScript async function.
+   Its co_return value fulfills the promise and is converted like the
+   result of a typed function. An exception that escapes it rejects
+   the promise with an Error.
+
+   Every path through the coroutine must end in a co_return with a
+   value; flowing off the end is undefined behavior. Use JSVoidTask
+   for a coroutine that returns nothing.
+
+   A JSFunctionCallback can start a coroutine and return its
+   get_promise() to the script.
+   */
+  class JSTask final HAL_PERFORMANCE_COUNTER1(JSTask) {
+
+  public:
+
+    class promise_type final : public detail::JSTaskPromise<JSTask> {
+
+    public:
+
+      using detail::JSTaskPromise<JSTask>::JSTaskPromise;
+
+      template<typename T>
+      void return_value(const T& value) {
+        deferred__.second.Resolve(value);
+      }
+    };
+
+    /*!
+     @method
+
+     @abstract Return the JavaScript promise of the coroutine.
+     */
+    JSObject get_promise() const HAL_NOEXCEPT {
+      return promise__;
+    }
+
+  private:
+
+    friend class detail::JSTaskPromise<JSTask>;
+
+    explicit JSTask(const JSObject& promise) HAL_NOEXCEPT
+    : promise__(promise) {
+    }
+
+    JSObject promise__;
+  };
+
+  /*!
+   @class
+
+   @discussion The return type of a native coroutine that is exposed
+   to JavaScript as a promise of undefined.
+
+   It is a JSTask whose coroutine returns nothing: a bare co_return,
+   or flowing off the end, fulfills the promise with undefined.
+   */
+  class JSVoidTask final HAL_PERFORMANCE_COUNTER1(JSVoidTask) {
+
+  public:
+
+    class promise_type final : public detail::JSTaskPromise<JSVoidTask> {
+
+    public:
+
+      using detail::JSTaskPromise<JSVoidTask>::JSTaskPromise;
+
+      void return_void() {
+        deferred__.second.Resolve();
+      }
+    };
+
+    /*!
+     @method
+
+     @abstract Return the JavaScript promise of the coroutine.
+     */
+    JSObject get_promise() const HAL_NOEXCEPT {
+      return promise__;
+    }
+
+  private:
+
+    friend class detail::JSTaskPromise<JSVoidTask>;
+
+    explicit JSVoidTask(const JSObject& promise) HAL_NOEXCEPT
+    : promise__(promise) {
+    }
+
+    JSObject promise__;
+  };
+
+} // namespace HAL {
+
+#endif // HAL_HAS_COROUTINES
+
+#endif // _HAL_JSCOROUTINE_HPP_
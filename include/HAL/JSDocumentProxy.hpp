@@ -0,0 +1,238 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSDOCUMENTPROXY_HPP_
+#define _HAL_JSDOCUMENTPROXY_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+namespace HAL {
+
+  class JSContext;
+  class JSString;
+  class JSValue;
+  class JSObject;
+  class JSDocumentNode;
+  class JSDocumentProxy;
+
+  /*!
+   @class
+
+   @discussion A JSDocumentVisitor receives the value of one property
+   or element of a JSDocumentNode and converts it to a JavaScript
+   value.
+
+   A JSDocumentNode calls exactly one of the Visit member functions.
+   Child nodes are wrapped in a new proxy, so their own properties are
+   only read when a script accesses them.
+
+   JSDocumentVisitors are only created by HAL.
+   */
+  class HAL_EXPORT JSDocumentVisitor final HAL_PERFORMANCE_COUNTER1(JSDocumentVisitor) {
+
+  public:
+
+    void VisitUndefined()                                         HAL_NOEXCEPT;
+    void VisitNull()                                              HAL_NOEXCEPT;
+    void VisitBoolean(bool boolean)                               HAL_NOEXCEPT;
+    void VisitNumber(double number)                               HAL_NOEXCEPT;
+    void VisitString(const char* string)                          HAL_NOEXCEPT;
+    void VisitString(const std::string& string)                   HAL_NOEXCEPT;
+    void VisitString(const JSString& string)                      HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Visit an arbitrary JavaScript value, which must belong
+     to the same context group as the proxy.
+     */
+    void VisitValue(const JSValue& js_value)                      HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Visit a child node, which is exposed to JavaScript as
+     another proxy. A null node is visited as null.
+     */
+    void VisitNode(const std::shared_ptr<JSDocumentNode>& node);
+
+    JSDocumentVisitor(const JSDocumentVisitor&)            = delete;
+    JSDocumentVisitor& operator=(const JSDocumentVisitor&) = delete;
+
+  private:
+
+    // Only a JSDocumentProxy can create a JSDocumentVisitor.
+    friend class JSDocumentProxy;
+
+    JSDocumentVisitor(JSContextRef context_ref, bool cache_children) HAL_NOEXCEPT;
+
+    JSContextRef context_ref__;
+    JSValueRef   value_ref__    { nullptr };
+    bool         cache_children__;
+    bool         visited_node__ { false };
+  };
+
+  /*!
+   @class
+
+   @discussion A JSDocumentNode is the interface that a native
+   document tree, such as a parsed configuration file or a decoded
+   message, implements in order to be read lazily from JavaScript
+   through JSContext::CreateDocumentProxy.
+
+   A node is either an object with named properties or, if IsArray
+   returns true, an array with GetLength elements. Nodes are read-only
+   from JavaScript.
+
+   JSDocumentNode member functions are called on the thread that runs
+   the script. A C++ exception thrown by a node is rethrown in
+   JavaScript as an Error.
+   */
+  class HAL_EXPORT JSDocumentNode {
+
+  public:
+
+    virtual ~JSDocumentNode() HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return whether this node is an array. The proxy of an
+     array node has Array.prototype as its prototype.
+     */
+    virtual bool IsArray() const {
+      return false;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the number of elements of an array node.
+     */
+    virtual std::size_t GetLength() const {
+      return 0;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the names of the properties of an object node,
+     e.g. for Object.keys and for...in.
+     */
+    virtual std::vector<std::string> GetPropertyNames() const {
+      return std::vector<std::string>();
+    }
+
+    /*!
+     @method
+
+     @abstract Return whether an object node has a property. The
+     default implementation searches GetPropertyNames.
+     */
+    virtual bool HasProperty(const std::string& property_name) const;
+
+    /*!
+     @method
+
+     @abstract Give the value of a property of an object node to
+     visitor.
+
+     @result true if the property exists, in which case exactly one
+     of the visitor's Visit member functions must have been called.
+     */
+    virtual bool VisitProperty(const std::string& /* property_name */, JSDocumentVisitor& /* visitor */) const {
+      return false;
+    }
+
+    /*!
+     @method
+
+     @abstract Give the value of an element of an array node to
+     visitor.
+
+     @result true if the element exists, in which case exactly one of
+     the visitor's Visit member functions must have been called.
+     */
+    virtual bool VisitElement(std::size_t /* index */, JSDocumentVisitor& /* visitor */) const {
+      return false;
+    }
+  };
+
+  /*!
+   @class
+
+   @discussion A JSDocumentProxy exposes a JSDocumentNode to
+   JavaScript through JavaScriptCore class callbacks.
+
+   A property is converted only when a script reads it, so a script
+   that reads a few fields of a large document pays for those fields
+   alone. When child caching is enabled each child proxy is created
+   once and stored on its parent, so repeated reads return the same
+   object.
+
+   The only way to create a JSDocumentProxy is by using the
+   JSContext::CreateDocumentProxy member function.
+   */
+  class HAL_EXPORT JSDocumentProxy final HAL_PERFORMANCE_COUNTER1(JSDocumentProxy) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Return the native node exposed by a JavaScript object
+     created by JSContext::CreateDocumentProxy.
+
+     @result The native node, or nullptr if js_object is not a
+     document proxy.
+     */
+    static std::shared_ptr<JSDocumentNode> GetNode(const JSObject& js_object) HAL_NOEXCEPT;
+
+    JSDocumentProxy() = delete;
+
+  private:
+
+    // Only JSContext and JSDocumentVisitor can create a
+    // JSDocumentProxy.
+    friend class JSContext;
+    friend class JSDocumentVisitor;
+
+    struct PrivateData {
+      std::shared_ptr<JSDocumentNode> node;
+      bool                            cache_children { true };
+      bool                            is_array { false };
+      // The names of the child proxies stored on the JavaScript
+      // object.
+      std::unordered_set<std::string> cached_names;
+      bool                            caching { false };
+    };
+
+    static JSObjectRef Make(JSContextRef context_ref, const std::shared_ptr<JSDocumentNode>& node, bool cache_children);
+
+    static JSClassRef   Class() HAL_NOEXCEPT;
+    static PrivateData& GetPrivateData(JSObjectRef object_ref) HAL_NOEXCEPT;
+
+    static JSValueRef MakeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT;
+    static void       CacheChild(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, const std::string& property_name, JSValueRef child_ref);
+
+    // The JavaScriptCore C API callbacks.
+    static bool       HasPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref);
+    static JSValueRef GetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception);
+    static bool       SetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef value_ref, JSValueRef* exception);
+    static void       GetPropertyNamesCallback(JSContextRef context_ref, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names);
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSDOCUMENTPROXY_HPP_
@@ -12,7 +12,7 @@
 #include "HAL/JSValue.hpp"
 #include "HAL/JSObject.hpp"
 #include <vector>
-#include <deque> 
+#include <cstddef>
 
 namespace HAL {
 
@@ -26,12 +26,52 @@ namespace HAL {
 */
 class HAL_EXPORT JSError final : public JSObject HAL_PERFORMANCE_COUNTER2(JSError) {
  public:
-#pragma warning(push)
-#pragma warning(disable : 4251)
- 	static std::deque<std::string> NativeStack__;
- 	static std::string GetNativeStack();
- 	static void ClearNativeStack();
-#pragma warning(pop)
+	/*!
+	  @class
+
+	  @discussion A frame of the native stack, which is pushed for the
+	  lifetime of a call into an exported function.
+
+	  The native stack of each thread is a fixed-capacity ring buffer
+	  holding the most recent NativeStackCapacity frames. A frame only
+	  stores pointers to its names, which must outlive it, and it is
+	  formatted only when an error needs the native stack.
+	*/
+	class NativeStackFrame final {
+	 public:
+		NativeStackFrame(const char* class_name, const char* function_name) HAL_NOEXCEPT {
+			PushNativeStack(class_name, function_name);
+		}
+
+		~NativeStackFrame() HAL_NOEXCEPT {
+			PopNativeStack();
+		}
+
+		NativeStackFrame(const NativeStackFrame&)            = delete;
+		NativeStackFrame& operator=(const NativeStackFrame&) = delete;
+	};
+
+	static const std::size_t NativeStackCapacity = 10;
+
+	/*!
+	  @method
+
+	  @abstract Return the native stack of the calling thread, innermost
+	  frame first.
+	*/
+	static std::string GetNativeStack();
+
+	/*!
+	  @method
+
+	  @abstract Return whether the calling thread is inside an exported
+	  function, without formatting the native stack.
+	*/
+	static bool HasNativeStack() HAL_NOEXCEPT;
+
+	static void ClearNativeStack() HAL_NOEXCEPT;
+	static void PushNativeStack(const char* class_name, const char* function_name) HAL_NOEXCEPT;
+	static void PopNativeStack() HAL_NOEXCEPT;
 
  	std::string message() const;
  	std::string name() const;
@@ -0,0 +1,174 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSEVENTEMITTER_HPP_
+#define _HAL_JSEVENTEMITTER_HPP_
+
+#include "HAL/JSExportObject.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSString.hpp"
+
+#include <cstddef>
+#include <unordered_map>
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSEventEmitter is a publish/subscribe channel between
+   native code and scripts whose listeners are kept natively instead
+   of in a JavaScript array.
+
+   Scripts use the on, once, off, removeAllListeners, listenerCount
+   and emit functions, and native code uses the matching member
+   functions of the JSEventEmitter returned by
+   js_object.GetPrivateReference<JSEventEmitter>().
+
+   An emit converts its arguments once and gives the same raw values
+   to every listener, with the emitter as 'this'. Every listener is
+   called even if an earlier one throws. The exceptions are collected
+   and reported once, after the last listener: by the Emit overload
+   that returns them, or by an AggregateError whose message lists them.
+
+   Listeners added during an emit are first called by the next emit,
+   and listeners removed during an emit are not called by it.
+
+   The listeners are held natively as protected JSObjects, which the
+   garbage collector treats as roots. A listener that refers to its
+   emitter, e.g. a closure over the variable holding it, therefore
+   keeps the emitter and every listener alive until the listener is
+   removed. Remove such listeners with off or removeAllListeners when
+   the emitter is no longer needed.
+
+   A JSEventEmitter is not thread safe. The only way to create a
+   JSEventEmitter is by using the JSContext::CreateEventEmitter member
+   function.
+   */
+  class HAL_EXPORT JSEventEmitter final : public JSExportObject, public JSExport<JSEventEmitter> HAL_PERFORMANCE_COUNTER2(JSEventEmitter) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Add a listener for an event. A listener added more than
+     once is called once for each time it was added.
+
+     @throws std::invalid_argument if listener is not a function.
+     */
+    void On(const JSString& event_name, const JSObject& listener);
+
+    /*!
+     @method
+
+     @abstract Add a listener that is removed before it is first
+     called.
+
+     @throws std::invalid_argument if listener is not a function.
+     */
+    void Once(const JSString& event_name, const JSObject& listener);
+
+    /*!
+     @method
+
+     @abstract Remove the most recently added instance of a listener.
+
+     @result true if the listener was found.
+     */
+    bool Off(const JSString& event_name, const JSObject& listener);
+
+    /*!
+     @method
+
+     @abstract Remove every listener of an event.
+     */
+    void RemoveAllListeners(const JSString& event_name);
+
+    /*!
+     @method
+
+     @abstract Return the number of listeners of an event.
+     */
+    std::size_t GetListenerCount(const JSString& event_name) const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Call every listener of an event with the given
+     arguments.
+
+     @result true if the event had listeners.
+
+     @throws std::runtime_error after the last listener if any
+     listener threw. The error's name is AggregateError and its
+     message lists the listeners' exceptions.
+     */
+    bool Emit(const JSString& event_name, const std::vector<JSValue>& arguments = std::vector<JSValue>());
+
+    /*!
+     @method
+
+     @abstract Call every listener of an event with the given
+     arguments, and append the exception thrown by each listener that
+     threw to errors.
+
+     @result true if the event had listeners.
+     */
+    bool Emit(const JSString& event_name, const std::vector<JSValue>& arguments, std::vector<JSValue>& errors);
+
+    JSEventEmitter(const JSContext& js_context) HAL_NOEXCEPT;
+
+    virtual ~JSEventEmitter()                        HAL_NOEXCEPT;
+    JSEventEmitter(const JSEventEmitter&)            = delete;
+    JSEventEmitter& operator=(const JSEventEmitter&) = delete;
+
+    static void JSExportInitialize();
+
+    JSValue js_on(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_once(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_off(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_removeAllListeners(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_listenerCount(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_emit(const JSArguments& arguments, JSObject& this_object);
+
+  private:
+
+    struct Listener {
+      Listener(const JSObject& function, bool once) HAL_NOEXCEPT
+      : function(function)
+      , once(once) {
+      }
+
+      JSObject function;
+      bool     once;
+      // Set when a listener is removed during an emit. It is erased
+      // once no emit is running.
+      bool     removed { false };
+    };
+
+    void AddListener(const JSString& event_name, const JSObject& listener, bool once);
+    bool Emit(const JSString& event_name, JSObjectRef this_object_ref, std::size_t argument_count, const JSValueRef arguments[], std::vector<JSValue>& errors);
+    void ThrowErrors(const JSString& event_name, const std::vector<JSValue>& errors) const;
+    void EraseRemovedListeners();
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    std::unordered_map<JSString, std::vector<Listener>> listeners__;
+#pragma warning(pop)
+
+    std::size_t emit_depth__ { 0 };
+    bool        has_removed_listeners__ { false };
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSEVENTEMITTER_HPP_
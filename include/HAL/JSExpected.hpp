@@ -0,0 +1,283 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSEXPECTED_HPP_
+#define _HAL_JSEXPECTED_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion The tag that selects the constructor of a JSExpected
+   holding a JavaScript exception.
+   */
+  struct JSUnexpected final {
+  };
+
+  /*!
+   @class
+
+   @discussion A JSExpected holds either the result of an operation or
+   the JavaScript exception that it threw, and is returned by the Try
+   methods, such as JSObject::TryGetProperty and
+   JSContext::TryEvaluateScript. The Try methods don't throw for
+   JavaScript exceptions, but may still throw std::bad_alloc.
+
+   Unlike their throwing counterparts, the Try methods neither unwind
+   nor log, so they are the cheaper choice for scripts that are
+   expected to throw, e.g. for validation or feature detection. The
+   exception is passed through untouched, whatever value the script
+   threw.
+
+   For example:
+
+   const auto result = js_context.TryEvaluateScript(script);
+   if (result) {
+     Use(*result);
+   } else {
+     Report(result.GetException());
+   }
+   */
+  template<typename T>
+  class JSExpected final {
+
+  public:
+
+    JSExpected(const T& value)
+    : has_value__(true) {
+      ::new (static_cast<void*>(&storage__)) T(value);
+    }
+
+    JSExpected(T&& value)
+    : has_value__(true) {
+      ::new (static_cast<void*>(&storage__)) T(std::move(value));
+    }
+
+    JSExpected(JSUnexpected, JSValue exception) HAL_NOEXCEPT
+    : has_value__(false) {
+      ::new (static_cast<void*>(&storage__)) JSValue(std::move(exception));
+    }
+
+    /*!
+     @method
+
+     @abstract Return whether this holds a result rather than an
+     exception.
+     */
+    bool HasValue() const HAL_NOEXCEPT {
+      return has_value__;
+    }
+
+    explicit operator bool() const HAL_NOEXCEPT {
+      return has_value__;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the result.
+
+     @throws std::runtime_error, as the throwing methods do, if this
+     holds an exception.
+     */
+    const T& GetValue() const {
+      if (!has_value__) {
+        detail::ThrowRuntimeError("JSExpected", StoredException());
+      }
+      return StoredValue();
+    }
+
+    /*!
+     @method
+
+     @abstract Return the result, or default_value if this holds an
+     exception.
+     */
+    T GetValueOr(const T& default_value) const {
+      return has_value__ ? StoredValue() : default_value;
+    }
+
+    /*!
+     @method
+
+     @abstract Return the exception. This must hold an exception.
+     */
+    const JSValue& GetException() const HAL_NOEXCEPT {
+      assert(!has_value__);
+      return StoredException();
+    }
+
+    const T& operator*() const HAL_NOEXCEPT {
+      assert(has_value__);
+      return StoredValue();
+    }
+
+    const T* operator->() const HAL_NOEXCEPT {
+      assert(has_value__);
+      return &StoredValue();
+    }
+
+    ~JSExpected() HAL_NOEXCEPT {
+      if (has_value__) {
+        StoredValue().~T();
+      } else {
+        StoredException().~JSValue();
+      }
+    }
+
+    JSExpected(const JSExpected& rhs)
+    : has_value__(rhs.has_value__) {
+      if (has_value__) {
+        ::new (static_cast<void*>(&storage__)) T(rhs.StoredValue());
+      } else {
+        ::new (static_cast<void*>(&storage__)) JSValue(rhs.StoredException());
+      }
+    }
+
+    JSExpected(JSExpected&& rhs)
+    : has_value__(rhs.has_value__) {
+      if (has_value__) {
+        ::new (static_cast<void*>(&storage__)) T(std::move(rhs.StoredValue()));
+      } else {
+        ::new (static_cast<void*>(&storage__)) JSValue(std::move(rhs.StoredException()));
+      }
+    }
+
+    JSExpected& operator=(JSExpected rhs) {
+      this->~JSExpected();
+      ::new (static_cast<void*>(this)) JSExpected(std::move(rhs));
+      return *this;
+    }
+
+  private:
+
+    const T& StoredValue() const HAL_NOEXCEPT {
+      return *reinterpret_cast<const T*>(&storage__);
+    }
+
+    T& StoredValue() HAL_NOEXCEPT {
+      return *reinterpret_cast<T*>(&storage__);
+    }
+
+    const JSValue& StoredException() const HAL_NOEXCEPT {
+      return *reinterpret_cast<const JSValue*>(&storage__);
+    }
+
+    JSValue& StoredException() HAL_NOEXCEPT {
+      return *reinterpret_cast<JSValue*>(&storage__);
+    }
+
+    bool has_value__;
+
+    // Either a T or a JSValue is constructed in the storage, so a
+    // failed operation never creates a default T. Raw storage is used
+    // rather than a union since compilers without unrestricted unions,
+    // such as Visual C++ 2013, are supported.
+    typename std::aligned_storage<(sizeof(T) > sizeof(JSValue) ? sizeof(T) : sizeof(JSValue)),
+                                  (std::alignment_of<T>::value > std::alignment_of<JSValue>::value ? std::alignment_of<T>::value : std::alignment_of<JSValue>::value)>::type storage__;
+  };
+
+  /*!
+   @class
+
+   @discussion A JSExpected for an operation without a result, which
+   holds either nothing or the JavaScript exception that it threw.
+   */
+  template<>
+  class JSExpected<void> final {
+
+  public:
+
+    JSExpected() HAL_NOEXCEPT
+    : has_value__(true) {
+    }
+
+    JSExpected(JSUnexpected, JSValue exception) HAL_NOEXCEPT
+    : has_value__(false) {
+      ::new (static_cast<void*>(&storage__)) JSValue(std::move(exception));
+    }
+
+    bool HasValue() const HAL_NOEXCEPT {
+      return has_value__;
+    }
+
+    explicit operator bool() const HAL_NOEXCEPT {
+      return has_value__;
+    }
+
+    /*!
+     @method
+
+     @abstract Throw std::runtime_error, as the throwing methods do,
+     if this holds an exception.
+     */
+    void GetValue() const {
+      if (!has_value__) {
+        detail::ThrowRuntimeError("JSExpected", StoredException());
+      }
+    }
+
+    const JSValue& GetException() const HAL_NOEXCEPT {
+      assert(!has_value__);
+      return StoredException();
+    }
+
+    ~JSExpected() HAL_NOEXCEPT {
+      if (!has_value__) {
+        StoredException().~JSValue();
+      }
+    }
+
+    JSExpected(const JSExpected& rhs)
+    : has_value__(rhs.has_value__) {
+      if (!has_value__) {
+        ::new (static_cast<void*>(&storage__)) JSValue(rhs.StoredException());
+      }
+    }
+
+    JSExpected(JSExpected&& rhs)
+    : has_value__(rhs.has_value__) {
+      if (!has_value__) {
+        ::new (static_cast<void*>(&storage__)) JSValue(std::move(rhs.StoredException()));
+      }
+    }
+
+    JSExpected& operator=(JSExpected rhs) {
+      this->~JSExpected();
+      ::new (static_cast<void*>(this)) JSExpected(std::move(rhs));
+      return *this;
+    }
+
+  private:
+
+    const JSValue& StoredException() const HAL_NOEXCEPT {
+      return *reinterpret_cast<const JSValue*>(&storage__);
+    }
+
+    JSValue& StoredException() HAL_NOEXCEPT {
+      return *reinterpret_cast<JSValue*>(&storage__);
+    }
+
+    bool has_value__;
+
+    typename std::aligned_storage<sizeof(JSValue), std::alignment_of<JSValue>::value>::type storage__;
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSEXPECTED_HPP_
@@ -114,8 +114,11 @@ namespace HAL {
      @method
      
      @abstract Return the JSClass for the C++ class T.
+     
+     @discussion The JSClass is created once, on first use, and the
+     same instance is returned on every subsequent call.
      */
-    static detail::JSExportClass<T> Class();
+    static const detail::JSExportClass<T>& Class();
     
     /*
      @method
@@ -293,6 +296,74 @@ namespace HAL {
      */
     static void AddFunctionProperty(const JSString& function_name, detail::CallNamedFunctionCallback<T> function_callback, bool enumerable = true);
     
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     member function is given a JSArguments view of its arguments.
+     
+     @discussion The arguments are neither copied into a
+     std::vector<JSValue> nor protected, so this is the cheaper form
+     for small, getter-like functions. For example, given this class
+     definition:
+     
+     class Foo {
+     JSValue Add(const JSArguments& arguments, JSObject& this_object);
+     };
+     
+     You would call AddFunctionProperty like this:
+     
+     AddFunctionProperty("add", &Foo::Add);
+     
+     @throws std::invalid_argument exception under these
+     preconditions:
+     
+     1. If function_name is empty.
+     
+     2. If method is null.
+     
+     3. You have already added a property with the same property_name.
+     */
+    static void AddFunctionProperty(const JSString& function_name, JSValue (T::*method)(const JSArguments&, JSObject&), bool enumerable = true);
+    
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     member function runs on a native thread pool, so that slow native
+     work doesn't stall the context's thread.
+     
+     @discussion The JavaScript function returns a Promise. Its
+     arguments are converted to Args... like the arguments of a typed
+     function, and the member function is called on a pool thread with
+     its own copy of them, so it must not use any JavaScript value.
+     Its result, or the message of the exception it threw, settles the
+     promise when the host calls thread_pool->RunCompletions on the
+     context's thread. For example, given this class definition:
+     
+     class Foo {
+     std::string Compress(const std::string& text);
+     };
+     
+     You would call AddAsyncFunctionProperty like this:
+     
+     AddAsyncFunctionProperty("compress", &Foo::Compress, thread_pool);
+     
+     @throws std::invalid_argument exception under these
+     preconditions:
+     
+     1. If function_name is empty.
+     
+     2. If method or thread_pool is null.
+     
+     3. You have already added a property with the same property_name.
+     */
+    template<typename R, typename... Args>
+    static void AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...), const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable = true);
+    
+    template<typename R, typename... Args>
+    static void AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...) const, const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable = true);
+    
     /*!
      @method
      
@@ -577,6 +648,23 @@ namespace HAL {
     builder__.AddFunctionProperty(function_name, function_callback, enumerable);
   }
   
+  template<typename T>
+  void JSExport<T>::AddFunctionProperty(const JSString& function_name, JSValue (T::*method)(const JSArguments&, JSObject&), bool enumerable) {
+    builder__.AddFunctionProperty(function_name, method, enumerable);
+  }
+  
+  template<typename T>
+  template<typename R, typename... Args>
+  void JSExport<T>::AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...), const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable) {
+    builder__.AddAsyncFunctionProperty(function_name, method, thread_pool, enumerable);
+  }
+  
+  template<typename T>
+  template<typename R, typename... Args>
+  void JSExport<T>::AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...) const, const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable) {
+    builder__.AddAsyncFunctionProperty(function_name, method, thread_pool, enumerable);
+  }
+  
   template<typename T>
   void JSExport<T>::AddHasPropertyCallback(const detail::HasPropertyCallback<T>& has_property_callback) {
     builder__.HasProperty(has_property_callback);
@@ -616,7 +704,7 @@ namespace HAL {
   detail::JSExportClassDefinitionBuilder<T> JSExport<T>::builder__ = detail::JSExportClassDefinitionBuilder<T>(typeid(T).name());
   
   template<typename T>
-  detail::JSExportClass<T> JSExport<T>::Class() {
+  const detail::JSExportClass<T>& JSExport<T>::Class() {
     static detail::JSExportClassDefinition<T> js_export_class_definition;
     static detail::JSExportClass<T>           js_export_class;
     static std::once_flag                     of;
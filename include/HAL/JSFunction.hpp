@@ -10,12 +10,26 @@
 #define _HAL_JSFUNCTION_HPP_
 
 #include "HAL/JSObject.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include <cmath>
+#include <cstddef>
 #include <functional>
-#include <unordered_map>
+#include <limits>
+#include <string>
+#include <tuple>
+#include <type_traits>
 
 namespace HAL {
 
     
+namespace detail {
+	template<typename Signature>
+	class JSTypedFunction;
+} // namespace detail {
+
 /*!
   @class
   
@@ -24,24 +38,19 @@ namespace HAL {
   to execute a script repeatedly to avoid the cost of re-parsing the
   script before each execution.
 
+  A JSFunction may also be implemented by a native JSFunctionCallback,
+  or by a JSArgumentsCallback that is given a JSArguments view of its
+  arguments instead of a std::vector<JSValue>. The callback is owned
+  by the JavaScript function object itself, so calling it costs a
+  single pointer dereference, copies of a JSFunction share the same
+  function object, and the callback is destroyed when the garbage
+  collector finalizes the function.
+
   The only way to create a JSFunction is by using the
   JSContext::CreateFunction member function.
 */
 class HAL_EXPORT JSFunction final : public JSObject HAL_PERFORMANCE_COUNTER2(JSFunction) {
 
-public:
-    
-    static void RegisterJSFunctionCallback(JSObjectRef js_object_ref, JSFunctionCallback);
-    static void UnRegisterJSFunctionCallback(JSObjectRef js_object_ref);
-    static JSFunctionCallback FindJSFunctionCallback(JSObjectRef js_object_ref);
-
-    JSFunction(const JSFunction& rhs);
-    JSFunction(JSFunction&& rhs);
-    JSFunction& operator=(const JSFunction& rhs);
-    JSFunction& operator=(JSFunction&& rhs);
-
-    virtual ~JSFunction() HAL_NOEXCEPT;
-
 private:
     
     // Only a JSContext can create a JSFunction.
@@ -49,23 +58,287 @@ private:
     
     JSFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number);
     JSFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback);
+    JSFunction(const JSContext& js_context, const JSString& function_name, const JSArgumentsCallback& callback);
 
     static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& function_name, const JSString& source_url, int starting_line_number);
 
-    static JSValueRef  JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
     static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback);
 
-    void RetainCallbackAfterCopy();
+    static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& function_name, const JSArgumentsCallback& callback);
+
+    // For interoperability with the JavaScriptCore C API.
+    JSFunction(const JSContext& js_context, JSObjectRef js_object_ref);
+
+    // Typed functions created by JSContext::CreateFunction<Signature>.
+    template<typename Signature>
+    friend class detail::JSTypedFunction;
+
+    // Create a callable object of js_class_ref, whose private data is
+    // private_data, with the given name and Function.prototype as its
+    // prototype.
+    static JSObjectRef MakeFunction(const JSContext& js_context, const JSString& function_name, JSClassRef js_class_ref, void* private_data);
+
+    // The JSClass of functions implemented by a JSFunctionCallback,
+    // whose private data is a heap allocated JSFunctionCallback.
+    static JSClassRef JSFunctionCallbackClass() HAL_NOEXCEPT;
+
+    static JSValueRef JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+
+    // The JSClass of functions implemented by a JSArgumentsCallback,
+    // whose private data is a heap allocated JSArgumentsCallback.
+    static JSClassRef JSArgumentsCallbackClass() HAL_NOEXCEPT;
+
+    static JSValueRef JSArgumentsCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception);
+};
+
+namespace detail {
+
+/*!
+  @class
+
+  @discussion Conversions of the arguments of a typed function from
+  raw JavaScriptCore values. Unlike the JSValue conversion operators
+  these don't coerce: a number parameter requires a number, an
+  integral parameter requires an integer that fits in the type, a
+  bool parameter requires a boolean, a string parameter requires a
+  string and an object parameter requires an object.
+
+  On a type mismatch Convert stores a TypeError in exception and
+  returns a default value. Convert does nothing once exception is
+  set, so the first mismatch is reported.
+*/
+template<typename T, typename Enable = void>
+struct JSTypedArgument;
+
+HAL_EXPORT JSValueRef MakeTypeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT;
+HAL_EXPORT JSValueRef MakeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT;
+// Convert a value to a UTF-8 std::string by the ToString rules. If
+// the conversion throws, the exception is stored in exception, if
+// given, and an empty string is returned.
+HAL_EXPORT std::string ToStdString(JSContextRef context_ref, JSValueRef js_value_ref, JSValueRef* exception = nullptr);
+
+inline JSValueRef MakeArgumentTypeError(JSContextRef context_ref, std::size_t index, const char* expected) HAL_NOEXCEPT {
+	return MakeTypeError(context_ref, "Argument " + std::to_string(index + 1) + " must be " + expected + ".");
+}
 
-    // Silence 4251 on Windows since private member variables do not
-    // need to be exported from a DLL.
-#pragma warning(push)
-#pragma warning(disable: 4251)
-    static std::unordered_map<std::intptr_t, JSFunctionCallback> js_object_ref_to_js_function__;
-#pragma warning(pop)
+template<typename T>
+struct JSTypedArgument<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type> {
+	static T Convert(JSContextRef context_ref, JSValueRef js_value_ref, std::size_t index, JSValueRef* exception) HAL_NOEXCEPT {
+		if (*exception) {
+			return T();
+		}
+		if (!JSValueIsNumber(context_ref, js_value_ref)) {
+			*exception = MakeArgumentTypeError(context_ref, index, "a number");
+			return T();
+		}
+		const double number = JSValueToNumber(context_ref, js_value_ref, nullptr);
+		// max() of a 64-bit integer rounds up to 2^63 or 2^64 as a
+		// double, so compare against that power of two exclusively.
+		if (std::is_integral<T>::value && !(std::trunc(number) == number && number >= static_cast<double>(std::numeric_limits<T>::lowest()) && number < std::ldexp(1.0, std::numeric_limits<T>::digits))) {
+			*exception = MakeArgumentTypeError(context_ref, index, "an integer in range");
+			return T();
+		}
+		return static_cast<T>(number);
+	}
+};
+
+template<>
+struct JSTypedArgument<bool> {
+	static bool Convert(JSContextRef context_ref, JSValueRef js_value_ref, std::size_t index, JSValueRef* exception) HAL_NOEXCEPT {
+		if (*exception) {
+			return false;
+		}
+		if (!JSValueIsBoolean(context_ref, js_value_ref)) {
+			*exception = MakeArgumentTypeError(context_ref, index, "a boolean");
+			return false;
+		}
+		return JSValueToBoolean(context_ref, js_value_ref);
+	}
+};
+
+template<>
+struct JSTypedArgument<std::string> {
+	static std::string Convert(JSContextRef context_ref, JSValueRef js_value_ref, std::size_t index, JSValueRef* exception) {
+		if (*exception) {
+			return std::string();
+		}
+		if (!JSValueIsString(context_ref, js_value_ref)) {
+			*exception = MakeArgumentTypeError(context_ref, index, "a string");
+			return std::string();
+		}
+		return ToStdString(context_ref, js_value_ref);
+	}
+};
+
+template<>
+struct JSTypedArgument<JSValue> {
+	static JSValue Convert(JSContextRef context_ref, JSValueRef js_value_ref, std::size_t, JSValueRef*) HAL_NOEXCEPT {
+		return JSValue(JSContext(context_ref), js_value_ref);
+	}
+};
+
+template<>
+struct JSTypedArgument<JSObject> {
+	static JSObject Convert(JSContextRef context_ref, JSValueRef js_value_ref, std::size_t index, JSValueRef* exception) {
+		const JSContext js_context(context_ref);
+		if (!*exception && !JSValueIsObject(context_ref, js_value_ref)) {
+			*exception = MakeArgumentTypeError(context_ref, index, "an object");
+		}
+		if (*exception) {
+			return js_context.CreateObject();
+		}
+		return JSObject(js_context, JSValueToObject(context_ref, js_value_ref, nullptr));
+	}
+};
+
+/*!
+  @class
+
+  @discussion Conversions of the result of a typed function to a raw
+  JavaScriptCore value.
+*/
+template<typename T, typename Enable = void>
+struct JSTypedResult;
 
+template<typename T>
+struct JSTypedResult<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type> {
+	static JSValueRef Convert(JSContextRef context_ref, T number) HAL_NOEXCEPT {
+		return JSValueMakeNumber(context_ref, static_cast<double>(number));
+	}
 };
 
+template<>
+struct JSTypedResult<bool> {
+	static JSValueRef Convert(JSContextRef context_ref, bool boolean) HAL_NOEXCEPT {
+		return JSValueMakeBoolean(context_ref, boolean);
+	}
+};
+
+template<>
+struct JSTypedResult<std::string> {
+	static JSValueRef Convert(JSContextRef context_ref, const std::string& string) HAL_NOEXCEPT {
+		JSStringRef js_string_ref = JSStringCreateWithUTF8CString(string.c_str());
+		JSValueRef  js_value_ref  = JSValueMakeString(context_ref, js_string_ref);
+		JSStringRelease(js_string_ref);
+		return js_value_ref;
+	}
+};
+
+template<typename T>
+struct JSTypedResult<T, typename std::enable_if<std::is_base_of<JSValue, T>::value>::type> {
+	static JSValueRef Convert(JSContextRef, const JSValue& js_value) HAL_NOEXCEPT {
+		return static_cast<JSValueRef>(js_value);
+	}
+};
+
+template<typename T>
+struct JSTypedResult<T, typename std::enable_if<std::is_base_of<JSObject, T>::value>::type> {
+	static JSValueRef Convert(JSContextRef, const JSObject& js_object) HAL_NOEXCEPT {
+		return static_cast<JSObjectRef>(js_object);
+	}
+};
+
+template<std::size_t... Is>
+struct JSIndexSequence {
+};
+
+template<std::size_t N, std::size_t... Is>
+struct JSMakeIndexSequence : JSMakeIndexSequence<N - 1, N - 1, Is...> {
+};
+
+template<std::size_t... Is>
+struct JSMakeIndexSequence<0, Is...> {
+	typedef JSIndexSequence<Is...> type;
+};
+
+/*!
+  @class
+
+  @discussion The JavaScriptCore callbacks of a function created by
+  JSContext::CreateFunction<R(Args...)>.
+
+  Each signature has its own JSClass, and each function owns its
+  std::function<R(Args...)> as private data. A call converts the raw
+  arguments directly to Args..., invokes the std::function and
+  converts its result directly back, without a std::vector<JSValue>.
+*/
+template<typename R, typename... Args>
+class JSTypedFunction<R(Args...)> final {
+
+public:
+
+	typedef std::function<R(Args...)> Callback;
+
+	static JSFunction Make(const JSContext& js_context, const JSString& function_name, const Callback& callback) {
+		// The finalizer of the function deletes the private data.
+		return JSFunction(js_context, JSFunction::MakeFunction(js_context, function_name, Class(), new Callback(callback)));
+	}
+
+private:
+
+	typedef std::tuple<typename std::decay<Args>::type...> Arguments;
+
+	static JSClassRef Class() HAL_NOEXCEPT {
+		static const JSClassRef js_class_ref = CreateFunctionClass(CallAsFunctionCallback, DeletePrivateData<Callback>);
+		return js_class_ref;
+	}
+
+	template<std::size_t... Is>
+	static JSValueRef Invoke(JSContextRef context_ref, const Callback& callback, const JSValueRef arguments_array[], JSValueRef* exception, JSIndexSequence<Is...>) {
+		// Braced initializers are evaluated in order, so the first type
+		// mismatch is the one reported.
+		Arguments arguments { JSTypedArgument<typename std::decay<Args>::type>::Convert(context_ref, arguments_array[Is], Is, exception)... };
+		if (*exception) {
+			return nullptr;
+		}
+		return Call(context_ref, callback, arguments, std::is_void<R>(), JSIndexSequence<Is...>());
+	}
+
+	template<std::size_t... Is>
+	static JSValueRef Call(JSContextRef context_ref, const Callback& callback, Arguments& arguments, std::false_type, JSIndexSequence<Is...>) {
+		return JSTypedResult<typename std::decay<R>::type>::Convert(context_ref, callback(std::get<Is>(arguments)...));
+	}
+
+	template<std::size_t... Is>
+	static JSValueRef Call(JSContextRef context_ref, const Callback& callback, Arguments& arguments, std::true_type, JSIndexSequence<Is...>) {
+		callback(std::get<Is>(arguments)...);
+		return JSValueMakeUndefined(context_ref);
+	}
+
+	static JSValueRef CallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) {
+		if (argument_count < sizeof...(Args)) {
+			*exception = MakeTypeError(context_ref, "Expected " + std::to_string(sizeof...(Args)) + " arguments but got " + std::to_string(argument_count) + ".");
+			return nullptr;
+		}
+
+		const auto callback_ptr = static_cast<Callback*>(JSObjectGetPrivate(function_ref));
+		try {
+			return Invoke(context_ref, *callback_ptr, arguments_array, exception, typename JSMakeIndexSequence<sizeof...(Args)>::type());
+		} catch (const js_runtime_error& e) {
+			// Rethrow a script's Error untouched.
+			*exception = static_cast<JSValueRef>(e.js_error());
+		} catch (const std::exception& e) {
+			*exception = MakeError(context_ref, e.what());
+		} catch (...) {
+			*exception = MakeError(context_ref, "unknown exception");
+		}
+		return nullptr;
+	}
+};
+
+} // namespace detail {
+
+template<typename Signature, typename Callable>
+JSFunction JSContext::CreateFunction(Callable callable) const {
+	return CreateFunction<Signature>(JSString(), callable);
+}
+
+template<typename Signature, typename Callable>
+JSFunction JSContext::CreateFunction(const JSString& function_name, Callable callable) const {
+	HAL_JSCONTEXT_LOCK_GUARD;
+	return detail::JSTypedFunction<Signature>::Make(JSContext(js_global_context_ref__), function_name, callable);
+}
+
 } // namespace HAL {
 
 #endif // _HAL_JSFUNCTION_HPP_
@@ -0,0 +1,282 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSNATIVEARRAY_HPP_
+#define _HAL_JSNATIVEARRAY_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/JSValue.hpp"
+
+#include <cmath>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion Conversions between an element of a JSNativeArray and
+   a raw JavaScriptCore value. Numbers follow the same rules as the
+   JSValue conversion operators, i.e. ToNumber, and ToInt32 for
+   integral types of up to 32 bits. Wider integral types are reduced
+   modulo 2^64 instead, so every number a double holds exactly is
+   stored exactly.
+   */
+  template<typename T, typename Enable = void>
+  struct JSNativeArrayElement;
+
+  template<typename T>
+  struct JSNativeArrayElement<T, typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value>::type> {
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, const T& value) {
+      return JSValueMakeNumber(context_ref, static_cast<double>(value));
+    }
+
+    static T FromJSValueRef(JSContextRef context_ref, JSValueRef value_ref, JSValueRef* exception) {
+      const double number = JSValueToNumber(context_ref, value_ref, exception);
+      return FromNumber(number, std::integral_constant<int, std::is_floating_point<T>::value ? 0 : sizeof(T) <= 4 ? 1 : 2>());
+    }
+
+  private:
+
+    static T FromNumber(double number, std::integral_constant<int, 0>) {
+      return static_cast<T>(number);
+    }
+
+    static T FromNumber(double number, std::integral_constant<int, 1>) {
+      return static_cast<T>(to_int32_t(number));
+    }
+
+    static T FromNumber(double number, std::integral_constant<int, 2>) {
+      if (std::isnan(number) || std::isinf(number)) {
+        return T();
+      }
+      // Like ToInt32 but modulo 2^64. The magnitude is reduced before
+      // the conversion to uint64_t, which is undefined out of range.
+      const double magnitude = std::fmod(std::trunc(std::fabs(number)), 18446744073709551616.0);
+      const auto   bits      = static_cast<uint64_t>(magnitude);
+      return static_cast<T>(number < 0 ? 0 - bits : bits);
+    }
+  };
+
+  template<>
+  struct JSNativeArrayElement<bool> {
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, bool value) {
+      return JSValueMakeBoolean(context_ref, value);
+    }
+
+    static bool FromJSValueRef(JSContextRef context_ref, JSValueRef value_ref, JSValueRef*) {
+      return to_bool(context_ref, value_ref);
+    }
+  };
+
+  template<>
+  struct JSNativeArrayElement<std::string> {
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, const std::string& value) {
+      JSStringRef string_ref = JSStringCreateWithUTF8CString(value.c_str());
+      JSValueRef  value_ref  = JSValueMakeString(context_ref, string_ref);
+      JSStringRelease(string_ref);
+      return value_ref;
+    }
+
+    static std::string FromJSValueRef(JSContextRef context_ref, JSValueRef value_ref, JSValueRef* exception) {
+      JSStringRef string_ref = JSValueToStringCopy(context_ref, value_ref, exception);
+      if (!string_ref) {
+        return std::string();
+      }
+      std::string value(JSStringGetMaximumUTF8CStringSize(string_ref), '\0');
+      const auto size = JSStringGetUTF8CString(string_ref, &value[0], value.size());
+      JSStringRelease(string_ref);
+      value.resize(size > 0 ? size - 1 : 0);
+      return value;
+    }
+  };
+
+}} // namespace HAL { namespace detail {
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSNativeArray exposes a native std::vector<T> to
+   JavaScript as an array-like object without copying it.
+
+   Reading an index or 'length' reads the native vector, and assigning
+   to an existing index writes the native vector. The object's
+   prototype is Array.prototype, so forEach, map, for...of and the
+   other generic Array methods work on it. The vector can't be resized
+   from JavaScript, so assignments to 'length' and to indices past the
+   end, e.g. by push, are ignored.
+
+   Property names are parsed as array indices directly from the
+   property name's UTF-16 characters, and elements are converted to
+   and from raw JavaScriptCore values, so an element access creates
+   no JSString, JSValue or JSObject wrapper.
+
+   T may be any arithmetic type, bool or std::string. The JSClass for
+   each T is created once and shared by all of its instances.
+
+   The only way to create a JSNativeArray is by using the
+   JSContext::CreateNativeArray member function.
+   */
+  template<typename T>
+  class JSNativeArray final HAL_PERFORMANCE_COUNTER1(JSNativeArray<T>) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Return the native vector exposed by a JavaScript object
+     created by JSContext::CreateNativeArray<T>.
+
+     @result The native vector, or nullptr if js_object was not
+     created by JSContext::CreateNativeArray<T>.
+     */
+    static std::shared_ptr<std::vector<T>> GetStorage(const JSObject& js_object) HAL_NOEXCEPT {
+      const auto context_ref = static_cast<JSContextRef>(js_object.get_context());
+      const auto object_ref  = static_cast<JSObjectRef>(js_object);
+      if (!JSValueIsObjectOfClass(context_ref, object_ref, Class())) {
+        return nullptr;
+      }
+      return *static_cast<std::shared_ptr<std::vector<T>>*>(JSObjectGetPrivate(object_ref));
+    }
+
+    JSNativeArray() = delete;
+
+  private:
+
+    // Only a JSContext can create a JSNativeArray.
+    friend JSContext;
+
+    static JSObject Make(const JSContext& js_context, const std::shared_ptr<std::vector<T>>& storage);
+
+    static JSClassRef Class() HAL_NOEXCEPT;
+
+    static std::vector<T>& GetVector(JSObjectRef object_ref) HAL_NOEXCEPT {
+      return **static_cast<std::shared_ptr<std::vector<T>>*>(JSObjectGetPrivate(object_ref));
+    }
+
+    static bool IsLength(JSStringRef property_name) HAL_NOEXCEPT {
+      return JSStringIsEqualToUTF8CString(property_name, "length");
+    }
+
+    // The JavaScriptCore C API callbacks.
+    static bool       HasPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name);
+    static JSValueRef GetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name, JSValueRef* exception);
+    static bool       SetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name, JSValueRef value_ref, JSValueRef* exception);
+    static void       GetPropertyNamesCallback(JSContextRef context_ref, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names);
+  };
+
+  template<typename T>
+  JSClassRef JSNativeArray<T>::Class() HAL_NOEXCEPT {
+    // Created once and never released, like the classes of
+    // detail::CreateFunctionClass.
+    static const JSClassRef js_class_ref = [] {
+      ::JSClassDefinition definition = kJSClassDefinitionEmpty;
+      definition.className         = "NativeArray";
+      definition.hasProperty       = HasPropertyCallback;
+      definition.getProperty       = GetPropertyCallback;
+      definition.setProperty       = SetPropertyCallback;
+      definition.getPropertyNames  = GetPropertyNamesCallback;
+      definition.finalize          = detail::DeletePrivateData<std::shared_ptr<std::vector<T>>>;
+      return ::JSClassCreate(&definition);
+    }();
+    return js_class_ref;
+  }
+
+  template<typename T>
+  JSObject JSNativeArray<T>::Make(const JSContext& js_context, const std::shared_ptr<std::vector<T>>& storage) {
+    if (!storage) {
+      detail::ThrowInvalidArgument("JSNativeArray", "The native storage of a JSNativeArray must not be null.");
+    }
+
+    // The finalizer of the class deletes the private data.
+    const auto context_ref = static_cast<JSContextRef>(js_context);
+    JSObject js_object(js_context, JSObjectMake(context_ref, Class(), new std::shared_ptr<std::vector<T>>(storage)));
+
+    const auto array = static_cast<JSObject>(js_context.get_global_object().GetProperty("Array"));
+    js_object.SetPrototype(array.GetProperty("prototype"));
+
+    return js_object;
+  }
+
+  template<typename T>
+  bool JSNativeArray<T>::HasPropertyCallback(JSContextRef, JSObjectRef object_ref, JSStringRef property_name) {
+    uint32_t index { 0 };
+    if (detail::to_array_index(property_name, index)) {
+      return index < GetVector(object_ref).size();
+    }
+    return IsLength(property_name);
+  }
+
+  template<typename T>
+  JSValueRef JSNativeArray<T>::GetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name, JSValueRef*) {
+    const auto& storage = GetVector(object_ref);
+    uint32_t index { 0 };
+    if (detail::to_array_index(property_name, index)) {
+      if (index < storage.size()) {
+        return detail::JSNativeArrayElement<T>::ToJSValueRef(context_ref, storage[index]);
+      }
+      return nullptr;
+    }
+
+    if (IsLength(property_name)) {
+      return JSValueMakeNumber(context_ref, static_cast<double>(storage.size()));
+    }
+
+    // Forward everything else to the prototype chain.
+    return nullptr;
+  }
+
+  template<typename T>
+  bool JSNativeArray<T>::SetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name, JSValueRef value_ref, JSValueRef* exception) {
+    auto& storage = GetVector(object_ref);
+    uint32_t index { 0 };
+    if (detail::to_array_index(property_name, index)) {
+      // An index past the end is ignored rather than stored as an own
+      // property, which would read as an element beyond length.
+      if (index < storage.size()) {
+        const auto value = detail::JSNativeArrayElement<T>::FromJSValueRef(context_ref, value_ref, exception);
+        if (!*exception) {
+          storage[index] = value;
+        }
+      }
+      return true;
+    }
+
+    // The length of the native storage is read-only.
+    return IsLength(property_name);
+  }
+
+  template<typename T>
+  void JSNativeArray<T>::GetPropertyNamesCallback(JSContextRef, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names) {
+    const auto size = GetVector(object_ref).size();
+    for (std::size_t index = 0; index < size; ++index) {
+      JSStringRef property_name = JSStringCreateWithUTF8CString(std::to_string(index).c_str());
+      JSPropertyNameAccumulatorAddName(property_names, property_name);
+      JSStringRelease(property_name);
+    }
+  }
+
+  template<typename T>
+  JSObject JSContext::CreateNativeArray(const std::shared_ptr<std::vector<T>>& storage) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSNativeArray<T>::Make(JSContext(js_global_context_ref__), storage);
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSNATIVEARRAY_HPP_
@@ -0,0 +1,99 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSNATIVEITERATOR_HPP_
+#define _HAL_JSNATIVEITERATOR_HPP_
+
+#include "HAL/JSExportObject.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSObjectTemplate.hpp"
+
+#include <functional>
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSNativeIterator is a JavaScript iterator whose
+   values are pulled from native code one at a time, so for...of,
+   spread and Array.from consume a native range or generator lazily
+   instead of from a materialized JSArray.
+
+   A JSNativeIterator is a JSExport class with 'next' and 'return'
+   functions whose prototype inherits from %IteratorPrototype%, so it
+   is also iterable. Each {value, done} result is stamped from a
+   JSObjectTemplate.
+
+   The only way to create a JSNativeIterator is by using the
+   JSContext::CreateIterator family of member functions.
+   */
+  class HAL_EXPORT JSNativeIterator final : public JSExportObject, public JSExport<JSNativeIterator> HAL_PERFORMANCE_COUNTER2(JSNativeIterator) {
+
+  public:
+
+    /*!
+     @typedef
+
+     @abstract The native source of an iterator's values.
+
+     @discussion Store the next value in value and return true, or
+     return false when there are no more values. value is undefined
+     on entry. The source is released once it is exhausted, when the
+     script leaves a for...of loop early, or when the iterator is
+     garbage collected.
+     */
+    typedef std::function<bool(JSValue& value)> Source;
+
+    JSNativeIterator(const JSContext& js_context) HAL_NOEXCEPT;
+
+    virtual ~JSNativeIterator()                          HAL_NOEXCEPT;
+    JSNativeIterator(const JSNativeIterator&)            = delete;
+    JSNativeIterator& operator=(const JSNativeIterator&) = delete;
+
+    static void JSExportInitialize();
+
+    // 'next' and 'return' are called once per element, so they take
+    // their arguments as a JSArguments.
+    JSValue js_next(const JSArguments& arguments, JSObject& this_object);
+    JSValue js_return(const JSArguments& arguments, JSObject& this_object);
+
+  private:
+
+    // Only a JSContext can create a JSNativeIterator.
+    friend class JSContext;
+
+    static JSObject Make(const JSContext& js_context, const Source& source);
+
+    JSObject MakeResult(const JSValue& value, bool done) const;
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    Source           source__;
+    JSObjectTemplate result_template__;
+#pragma warning(pop)
+  };
+
+  template<typename Iterator, typename Converter>
+  JSObject JSContext::CreateIterator(Iterator first, Iterator last, Converter converter) const {
+    return CreateIterator(JSNativeIterator::Source([first, last, converter](JSValue& value) mutable {
+      if (first == last) {
+        return false;
+      }
+      value = converter(*first);
+      ++first;
+      return true;
+    }));
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSNATIVEITERATOR_HPP_
@@ -15,6 +15,8 @@
 #include "HAL/JSPropertyNameArray.hpp"
 
 #include <memory>
+#include <type_traits>
+#include <typeinfo>
 #include <vector>
 #include <unordered_set>
 #include <unordered_map>
@@ -26,10 +28,20 @@ namespace HAL {
   class JSPropertyNameAccumulator;
   class JSPropertyNameArray;
   class JSArray;
+  class JSArrayBuffer;
   class JSError;
   
   class JSExportObject;
   
+  template<typename T>
+  class JSExport;
+  
+  template<typename T>
+  class JSTypedArray;
+  
+  template<typename T>
+  class JSExpected;
+  
   namespace detail {
     template<typename T>
     class JSExportClass;
@@ -115,14 +127,16 @@ namespace HAL {
      @param value The value of the the property to set.
      
      @param attributes An optional set of property attributes to give
-     to the property.
+     to the property. This is a bitmask, so a single attribute, a
+     braced list of attributes or a
+     std::unordered_set<JSPropertyAttribute> may be passed.
      
      @result true if the the property was set.
      
      @throws std::runtime_error if setting the property threw a
      JavaScript exception.
      */
-    virtual void SetProperty(const JSString& property_name, const JSValue& property_value, const std::unordered_set<JSPropertyAttribute>& attributes = {}) final;
+    virtual void SetProperty(const JSString& property_name, const JSValue& property_value, JSPropertyAttributeFlags attributes = JSPropertyAttributeFlags()) final;
     
     /*!
      @method
@@ -142,6 +156,23 @@ namespace HAL {
      */
     virtual void SetProperty(unsigned property_index, const JSValue& property_value) final;
     
+    /*!
+     @method
+     
+     @abstract Get or set a property of this JavaScript object without
+     throwing.
+     
+     @discussion These are GetProperty and SetProperty for properties
+     whose accessors are expected to throw. An exception thrown by an
+     accessor is returned as is, without being thrown or logged.
+     
+     @result The property's value, or the exception that was thrown.
+     */
+    virtual JSExpected<JSValue> TryGetProperty(const JSString& property_name) const final;
+    virtual JSExpected<JSValue> TryGetProperty(unsigned property_index) const final;
+    virtual JSExpected<void>    TrySetProperty(const JSString& property_name, const JSValue& property_value, JSPropertyAttributeFlags attributes = JSPropertyAttributeFlags()) final;
+    virtual JSExpected<void>    TrySetProperty(unsigned property_index, const JSValue& property_value) final;
+    
     /*!
      @method
      
@@ -207,6 +238,26 @@ namespace HAL {
      */
     virtual bool IsError() const HAL_NOEXCEPT final;
     
+    /*!
+     @method
+     
+     @abstract Determine whether this JavaScript object is an
+     ArrayBuffer.
+     
+     @result true if this JavaScript object is an ArrayBuffer.
+     */
+    virtual bool IsArrayBuffer() const HAL_NOEXCEPT final;
+    
+    /*!
+     @method
+     
+     @abstract Determine whether this JavaScript object is a typed
+     array of any element type, e.g. a Float32Array.
+     
+     @result true if this JavaScript object is a typed array.
+     */
+    virtual bool IsTypedArray() const HAL_NOEXCEPT final;
+    
     /*!
      @method
      
@@ -268,6 +319,25 @@ namespace HAL {
     virtual JSObject CallAsConstructor(const std::vector<JSString>& arguments) final;
     virtual JSObject CallAsConstructor(const std::vector<JSValue>&  arguments) final;
     
+    /*!
+     @method
+     
+     @abstract Call this JavaScript object as a function, or as a
+     constructor, without throwing.
+     
+     @discussion An exception thrown by the call is returned as is,
+     without being thrown or logged. Calling an object that isn't a
+     function, or a constructor, returns a TypeError.
+     
+     @param arguments The JSValue arguments to pass.
+     
+     @param this_object The JavaScript object to use as 'this'.
+     
+     @result The call's return value, or the exception that it threw.
+     */
+    virtual JSExpected<JSValue>  TryCallAsFunction(const std::vector<JSValue>& arguments, JSObject this_object) final;
+    virtual JSExpected<JSObject> TryCallAsConstructor(const std::vector<JSValue>& arguments) final;
+    
     /*!
      @method
      
@@ -324,6 +394,32 @@ namespace HAL {
      @result A JSError with the result of conversion.
      */
     virtual operator JSError() const final;
+    
+    /*!
+     @method
+     
+     @abstract Convert this JSObject to a JSArrayBuffer.
+     
+     @result A JSArrayBuffer with the result of conversion.
+     
+     @throws std::runtime_error if this JavaScript object is not an
+     ArrayBuffer.
+     */
+    virtual operator JSArrayBuffer() const final;
+    
+    /*!
+     @method
+     
+     @abstract Convert this JSObject to a JSTypedArray<T>. Include
+     HAL/JSTypedArray.hpp to use this conversion.
+     
+     @result A JSTypedArray<T> with the result of conversion.
+     
+     @throws std::invalid_argument if this JavaScript object is not a
+     typed array with elements of type T.
+     */
+    template<typename T>
+    operator JSTypedArray<T>() const;
   
     /*!
      @method
@@ -337,6 +433,43 @@ namespace HAL {
     template<typename T>
     std::shared_ptr<T> GetPrivate() const HAL_NOEXCEPT;
     
+    /*!
+     @method
+     
+     @abstract Return a borrowed pointer to this object's private
+     data.
+     
+     @discussion Unlike GetPrivate<T>, this neither allocates nor
+     touches a reference count nor uses RTTI. The class id is checked
+     by asking JavaScriptCore whether this object was created from
+     JSExport<T>::Class() or a JSClass derived from it, so it is cheap
+     enough to call on every argument of a JavaScript-facing method.
+     
+     The returned pointer is owned by this JavaScript object and is
+     only valid while the object is reachable from JavaScript or
+     protected by a JSObject.
+     
+     @result A T* to this object's private data if the object was
+     created from JSExport<T>::Class(), otherwise nullptr.
+     */
+    template<typename T>
+    T* GetPrivatePointer() const HAL_NOEXCEPT;
+    
+    /*!
+     @method
+     
+     @abstract Return a borrowed reference to this object's private
+     data. This is GetPrivatePointer<T> for callers that require the
+     object to be of type T.
+     
+     @result A T& to this object's private data.
+     
+     @throws std::invalid_argument if the object was not created from
+     JSExport<T>::Class() or has no private data.
+     */
+    template<typename T>
+    T& GetPrivateReference() const;
+    
     
     virtual ~JSObject()            HAL_NOEXCEPT;
     JSObject(const JSObject&)      HAL_NOEXCEPT;
@@ -429,6 +562,11 @@ namespace HAL {
      */
     virtual void GetPropertyNames(const JSPropertyNameAccumulator& accumulator) const HAL_NOEXCEPT final;
     
+    // Support for GetPrivatePointer and GetPrivateReference, which
+    // can't see the JSClass or JSUtil definitions from this header.
+    bool HasPrivateOfClass(const JSClass& js_class) const HAL_NOEXCEPT;
+    void ThrowInvalidPrivate(const char* type_name) const;
+    
     static void     RegisterJSContext(JSContextRef js_context_ref, JSObjectRef js_object_ref);
     static void     UnRegisterJSContext(JSObjectRef js_object_ref);
     static JSObject FindJSObject(JSContextRef js_context_ref, JSObjectRef js_object_ref);
@@ -473,6 +611,27 @@ namespace HAL {
     return std::shared_ptr<T>(std::make_shared<JSObject>(*this), dynamic_cast<T*>(static_cast<JSExportObject*>(GetPrivate())));
   }
   
+  template<typename T>
+  T* JSObject::GetPrivatePointer() const HAL_NOEXCEPT {
+    static_assert(std::is_base_of<JSExportObject, T>::value, "T must be derived from JSExportObject");
+    if (!HasPrivateOfClass(JSExport<T>::Class())) {
+      return nullptr;
+    }
+    
+    // JSExportClass stores the T* of the most derived class, and
+    // JSExportObject is always its first base.
+    return static_cast<T*>(static_cast<JSExportObject*>(GetPrivate()));
+  }
+  
+  template<typename T>
+  T& JSObject::GetPrivateReference() const {
+    const auto native_object_ptr = GetPrivatePointer<T>();
+    if (native_object_ptr == nullptr) {
+      ThrowInvalidPrivate(typeid(T).name());
+    }
+    return *native_object_ptr;
+  }
+  
 } // namespace HAL {
 
 #endif // _HAL_JSOBJECT_HPP_
@@ -0,0 +1,246 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSOBJECTTEMPLATE_HPP_
+#define _HAL_JSOBJECTTEMPLATE_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/JSArray.hpp"
+#include "HAL/JSArrayBuilder.hpp"
+#include "HAL/JSPropertyAttribute.hpp"
+
+#include <cstddef>
+#include <initializer_list>
+#include <iterator>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSObjectTemplate describes the shape of plain
+   JavaScript objects that all have the same properties, in the same
+   order and with the same attributes, such as the records returned by
+   a query.
+
+   The property names are created once as JSStrings and their
+   attributes are converted once, so stamping out an object costs one
+   JSObjectMake plus one JSObjectSetProperty per property. Because
+   every object gets its properties in the same order, the engine
+   gives them all the same hidden structure.
+
+   Native numbers, booleans and strings are converted directly to raw
+   JavaScriptCore values without creating a JSValue wrapper for each
+   one.
+
+   A JSObjectTemplate is immutable and can be copied, but it is not
+   thread safe.
+   */
+  class HAL_EXPORT JSObjectTemplate final HAL_PERFORMANCE_COUNTER1(JSObjectTemplate) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a template for objects with the given properties.
+
+     @param js_context The execution context of the objects.
+
+     @param property_names The names of the properties, in the order
+     their values are given to CreateObject.
+
+     @param attributes The attributes of every property.
+     */
+    JSObjectTemplate(const JSContext& js_context, const std::vector<JSString>& property_names, JSPropertyAttributeFlags attributes = JSPropertyAttributeFlags());
+
+    // A braced list of names, such as {"x", "y"}, would otherwise be
+    // ambiguous, since it could also be an iterator range for the
+    // vector of properties below.
+    JSObjectTemplate(const JSContext& js_context, std::initializer_list<JSString> property_names, JSPropertyAttributeFlags attributes = JSPropertyAttributeFlags());
+
+    /*!
+     @method
+
+     @abstract Create a template for objects whose properties each
+     have their own attributes.
+     */
+    JSObjectTemplate(const JSContext& js_context, const std::vector<std::pair<JSString, JSPropertyAttributeFlags>>& properties);
+
+    /*!
+     @method
+
+     @abstract Return the number of properties of each object.
+     */
+    std::size_t GetPropertyCount() const HAL_NOEXCEPT {
+      return property_names__.size();
+    }
+
+    /*!
+     @method
+
+     @abstract Return the property names in the order their values
+     are given to CreateObject.
+     */
+    const std::vector<JSString>& GetPropertyNames() const HAL_NOEXCEPT {
+      return property_names__;
+    }
+
+    /*!
+     @method
+
+     @abstract Create an object with this template's properties set to
+     the given values.
+
+     @discussion The values may be given as JSValues, as a list of
+     native values or as a std::tuple of native values. A native value
+     may be an arithmetic type, bool, const char*, std::string,
+     JSString, JSValue or JSObject.
+
+     @throws std::invalid_argument if the number of values is not the
+     number of properties.
+
+     @throws std::runtime_error if setting a property threw a
+     JavaScript exception, e.g. from a setter on Object.prototype.
+     */
+    JSObject CreateObject(const std::vector<JSValue>& values) const;
+
+    template<typename... Ts>
+    JSObject CreateObject(const std::tuple<Ts...>& values) const;
+
+    template<typename... Ts>
+    JSObject CreateObject(const Ts&... values) const;
+
+    /*!
+     @method
+
+     @abstract Create an Array of objects from a range of native
+     records.
+
+     @discussion The Array and all of its objects are created without
+     a JSObject wrapper for any of the objects.
+
+     @param first The beginning of a range of records that can be
+     traversed more than once.
+
+     @param last The end of the range of records.
+
+     @param projection A function that is given a record and returns
+     a std::tuple of its property values, e.g. by std::make_tuple or
+     std::tie.
+
+     @throws std::invalid_argument if a tuple does not have one value
+     per property.
+     */
+    template<typename ForwardIterator, typename Projection>
+    JSArray CreateArray(ForwardIterator first, ForwardIterator last, Projection projection) const;
+
+    template<typename... Ts>
+    JSArray CreateArray(const std::vector<std::tuple<Ts...>>& records) const;
+
+  private:
+
+    JSObject    MakeObject(const JSValueRef values[], std::size_t count) const;
+    JSObjectRef MakeObjectRef(const JSValueRef values[], std::size_t count) const;
+    void        AppendObject(JSArrayBuilder& builder, const JSValueRef values[], std::size_t count) const;
+
+    template<std::size_t I, typename... Ts>
+    static typename std::enable_if<I == sizeof...(Ts)>::type ToJSValueRefs(JSContextRef, const std::tuple<Ts...>&, JSValueRef[]) HAL_NOEXCEPT {
+    }
+
+    template<std::size_t I, typename... Ts>
+    static typename std::enable_if<I < sizeof...(Ts)>::type ToJSValueRefs(JSContextRef context_ref, const std::tuple<Ts...>& values, JSValueRef value_refs[]) HAL_NOEXCEPT {
+      value_refs[I] = ToJSValueRef(context_ref, std::get<I>(values));
+      ToJSValueRefs<I + 1>(context_ref, values, value_refs);
+    }
+
+    template<typename T>
+    static typename std::enable_if<std::is_arithmetic<T>::value && !std::is_same<T, bool>::value, JSValueRef>::type ToJSValueRef(JSContextRef context_ref, T number) HAL_NOEXCEPT {
+      return JSValueMakeNumber(context_ref, static_cast<double>(number));
+    }
+
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, bool boolean) HAL_NOEXCEPT {
+      return JSValueMakeBoolean(context_ref, boolean);
+    }
+
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, const JSString& string) HAL_NOEXCEPT {
+      return JSValueMakeString(context_ref, static_cast<JSStringRef>(string));
+    }
+
+    static JSValueRef ToJSValueRef(JSContextRef, const JSValue& js_value) HAL_NOEXCEPT {
+      return static_cast<JSValueRef>(js_value);
+    }
+
+    static JSValueRef ToJSValueRef(JSContextRef, const JSObject& js_object) HAL_NOEXCEPT {
+      return static_cast<JSObjectRef>(js_object);
+    }
+
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, const char* string) HAL_NOEXCEPT;
+    static JSValueRef ToJSValueRef(JSContextRef context_ref, const std::string& string) HAL_NOEXCEPT;
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    JSContext             js_context__;
+    std::vector<JSString> property_names__;
+    std::vector<unsigned> property_attributes__;
+#pragma warning(pop)
+  };
+
+  template<typename... Ts>
+  JSObject JSObjectTemplate::CreateObject(const std::tuple<Ts...>& values) const {
+    static_assert(sizeof...(Ts) > 0, "Use CreateObject(std::vector<JSValue>()) for a template without properties");
+    JSValueRef value_refs[sizeof...(Ts)];
+    ToJSValueRefs<0>(static_cast<JSContextRef>(js_context__), values, value_refs);
+    return MakeObject(value_refs, sizeof...(Ts));
+  }
+
+  template<typename... Ts>
+  JSObject JSObjectTemplate::CreateObject(const Ts&... values) const {
+    static_assert(sizeof...(Ts) > 0, "Use CreateObject(std::vector<JSValue>()) for a template without properties");
+    const auto context_ref = static_cast<JSContextRef>(js_context__);
+    // The raw values are on the stack, where the garbage collector
+    // finds them, so they don't need to be protected.
+    const JSValueRef value_refs[] = { ToJSValueRef(context_ref, values)... };
+    return MakeObject(value_refs, sizeof...(Ts));
+  }
+
+  template<typename ForwardIterator, typename Projection>
+  JSArray JSObjectTemplate::CreateArray(ForwardIterator first, ForwardIterator last, Projection projection) const {
+    const auto context_ref = static_cast<JSContextRef>(js_context__);
+    JSArrayBuilder builder(js_context__, static_cast<std::size_t>(std::distance(first, last)));
+    for (; first != last; ++first) {
+      const auto values = projection(*first);
+      using tuple_type = typename std::decay<decltype(values)>::type;
+      JSValueRef value_refs[std::tuple_size<tuple_type>::value];
+      ToJSValueRefs<0>(context_ref, values, value_refs);
+      AppendObject(builder, value_refs, std::tuple_size<tuple_type>::value);
+    }
+    return builder.Build();
+  }
+
+  template<typename... Ts>
+  JSArray JSObjectTemplate::CreateArray(const std::vector<std::tuple<Ts...>>& records) const {
+    return CreateArray(records.begin(), records.end(), [](const std::tuple<Ts...>& record) -> const std::tuple<Ts...>& {
+      return record;
+    });
+  }
+
+} // namespace HAL {
+
+#endif // _HAL_JSOBJECTTEMPLATE_HPP_
@@ -0,0 +1,133 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSPROMISE_HPP_
+#define _HAL_JSPROMISE_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSFunction.hpp"
+
+#include <memory>
+#include <string>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSPromiseResolver settles a JavaScript Promise created
+   by JSContext::CreatePromise, so that native code can start slow
+   work, return the promise to the script right away and resolve or
+   reject it when the work is done.
+
+   The first call to Resolve or Reject settles the promise and
+   releases its resolving functions; later calls are ignored. Copies
+   of a JSPromiseResolver share the same promise. A promise whose
+   resolvers are all destroyed without settling it stays pending.
+
+   A JSPromiseResolver must only be used on the thread that runs the
+   context's scripts. Work finished on another thread has to be handed
+   back to that thread before it is resolved.
+   */
+  class HAL_EXPORT JSPromiseResolver final HAL_PERFORMANCE_COUNTER1(JSPromiseResolver) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Fulfill the promise with a value.
+
+     @discussion value may be a JSValue or JSObject, or an arithmetic
+     type, bool or std::string, which is converted directly to a
+     JavaScript value.
+
+     @result true if this call settled the promise, false if it was
+     already settled.
+
+     @throws std::runtime_error if the resolving function threw a
+     JavaScript exception.
+     */
+    template<typename T>
+    bool Resolve(const T& value) {
+      return Settle(true, detail::JSTypedResult<T>::Convert(static_cast<JSContextRef>(get_context()), value));
+    }
+
+    /*!
+     @method
+
+     @abstract Fulfill the promise with undefined.
+     */
+    bool Resolve();
+
+    /*!
+     @method
+
+     @abstract Reject the promise with a reason.
+     */
+    bool Reject(const JSValue& reason);
+
+    /*!
+     @method
+
+     @abstract Reject the promise with a new Error whose message is
+     message.
+     */
+    bool Reject(const std::string& message);
+
+    /*!
+     @method
+
+     @abstract Return whether the promise was settled through this or
+     a copy of this resolver.
+     */
+    bool IsSettled() const HAL_NOEXCEPT;
+
+    /*!
+     @method
+
+     @abstract Return the execution context of the promise.
+     */
+    JSContext get_context() const HAL_NOEXCEPT;
+
+  private:
+
+    // Only a JSContext can create a JSPromiseResolver.
+    friend JSContext;
+
+    JSPromiseResolver(const JSContext& js_context, JSObjectRef resolve_ref, JSObjectRef reject_ref);
+
+    bool Settle(bool resolve, JSValueRef value_ref);
+
+    // The resolving functions are protected until the promise is
+    // settled, and the state is shared by copies of the resolver.
+    struct State {
+      State(const JSContext& js_context, JSObjectRef resolve_ref, JSObjectRef reject_ref) HAL_NOEXCEPT;
+      ~State() HAL_NOEXCEPT;
+      State(const State&)            = delete;
+      State& operator=(const State&) = delete;
+
+      void Release() HAL_NOEXCEPT;
+
+      JSContext   js_context;
+      JSObjectRef resolve_ref;
+      JSObjectRef reject_ref;
+    };
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    std::shared_ptr<State> state__;
+#pragma warning(pop)
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSPROMISE_HPP_
@@ -9,8 +9,13 @@
 #ifndef _HAL_JSPROPERTYATTRIBUTE_HPP_
 #define _HAL_JSPROPERTYATTRIBUTE_HPP_
 
+#include "HAL/detail/JSBase.hpp"
+
 #include <cstddef>
+#include <cstdint>
 #include <functional>
+#include <initializer_list>
+#include <unordered_set>
 
 namespace HAL {
 
@@ -36,7 +41,6 @@ enum class HAL_EXPORT JSPropertyAttribute : std::uint32_t /* typedef unsigned JS
 
 } // namespace HAL {
 
-
 // Provide a hash function so that a JSPropertyAttribute can be
 // stored in an unordered container.
 namespace std {
@@ -57,4 +61,157 @@ struct hash<JSPropertyAttribute> {
 
 }  // namespace std {
 
+namespace HAL {
+
+/*!
+  @class
+
+  @discussion A JSPropertyAttributeFlags is a set of
+  JSPropertyAttributes stored as a bitmask whose bits are identical to
+  the JavaScriptCore C API JSPropertyAttributes, so converting it for
+  the engine is free and constructing one never allocates. It is
+  usable at compile time:
+
+  constexpr auto attributes = JSPropertyAttribute::ReadOnly | JSPropertyAttribute::DontDelete;
+
+  For source compatibility it can be implicitly constructed from a
+  single JSPropertyAttribute, a braced list of them or a
+  std::unordered_set<JSPropertyAttribute>, and it provides the count
+  and insert members callers used on that set.
+*/
+class JSPropertyAttributeFlags final {
+	
+public:
+	
+	constexpr JSPropertyAttributeFlags() HAL_NOEXCEPT
+	: bits__(0) {
+	}
+	
+	constexpr JSPropertyAttributeFlags(JSPropertyAttribute attribute) HAL_NOEXCEPT
+	: bits__(ToBits(attribute)) {
+	}
+	
+	JSPropertyAttributeFlags(std::initializer_list<JSPropertyAttribute> attributes) HAL_NOEXCEPT
+	: bits__(0) {
+		for (const auto attribute : attributes) {
+			bits__ |= ToBits(attribute);
+		}
+	}
+	
+	JSPropertyAttributeFlags(const std::unordered_set<JSPropertyAttribute>& attributes) HAL_NOEXCEPT
+	: bits__(0) {
+		for (const auto attribute : attributes) {
+			bits__ |= ToBits(attribute);
+		}
+	}
+	
+	/*!
+	  @method
+	  
+	  @abstract Create a JSPropertyAttributeFlags from the JavaScriptCore
+	  C API JSPropertyAttributes bitmask.
+	*/
+	static constexpr JSPropertyAttributeFlags FromBits(std::uint32_t bits) HAL_NOEXCEPT {
+		return JSPropertyAttributeFlags(bits, 0);
+	}
+	
+	/*!
+	  @method
+	  
+	  @abstract Return the JavaScriptCore C API JSPropertyAttributes
+	  bitmask for these attributes.
+	*/
+	constexpr std::uint32_t bits() const HAL_NOEXCEPT {
+		return bits__;
+	}
+	
+	constexpr bool empty() const HAL_NOEXCEPT {
+		return bits__ == 0;
+	}
+	
+	/*!
+	  @method
+	  
+	  @abstract Determine whether an attribute is set. None is only
+	  contained in an empty set of attributes.
+	*/
+	constexpr bool contains(JSPropertyAttribute attribute) const HAL_NOEXCEPT {
+		return attribute == JSPropertyAttribute::None ? bits__ == 0 : (bits__ & ToBits(attribute)) != 0;
+	}
+	
+	constexpr std::size_t count(JSPropertyAttribute attribute) const HAL_NOEXCEPT {
+		return contains(attribute) ? 1 : 0;
+	}
+	
+	/*!
+	  @method
+	  
+	  @abstract Add an attribute.
+	  
+	  @result true if the attribute was not already set.
+	*/
+	bool insert(JSPropertyAttribute attribute) HAL_NOEXCEPT {
+		const bool inserted = !contains(attribute);
+		bits__ |= ToBits(attribute);
+		return inserted;
+	}
+	
+	void erase(JSPropertyAttribute attribute) HAL_NOEXCEPT {
+		bits__ &= ~ToBits(attribute);
+	}
+	
+	JSPropertyAttributeFlags& operator|=(JSPropertyAttributeFlags other) HAL_NOEXCEPT {
+		bits__ |= other.bits__;
+		return *this;
+	}
+	
+	operator std::unordered_set<JSPropertyAttribute>() const {
+		std::unordered_set<JSPropertyAttribute> attributes;
+		for (const auto attribute : {JSPropertyAttribute::ReadOnly, JSPropertyAttribute::DontEnum, JSPropertyAttribute::DontDelete}) {
+			if (contains(attribute)) {
+				attributes.insert(attribute);
+			}
+		}
+		return attributes;
+	}
+	
+	friend constexpr JSPropertyAttributeFlags operator|(JSPropertyAttributeFlags lhs, JSPropertyAttributeFlags rhs) HAL_NOEXCEPT {
+		return FromBits(lhs.bits__ | rhs.bits__);
+	}
+	
+	friend constexpr JSPropertyAttributeFlags operator&(JSPropertyAttributeFlags lhs, JSPropertyAttributeFlags rhs) HAL_NOEXCEPT {
+		return FromBits(lhs.bits__ & rhs.bits__);
+	}
+	
+	friend constexpr bool operator==(JSPropertyAttributeFlags lhs, JSPropertyAttributeFlags rhs) HAL_NOEXCEPT {
+		return lhs.bits__ == rhs.bits__;
+	}
+	
+	friend constexpr bool operator!=(JSPropertyAttributeFlags lhs, JSPropertyAttributeFlags rhs) HAL_NOEXCEPT {
+		return lhs.bits__ != rhs.bits__;
+	}
+	
+private:
+	
+	constexpr JSPropertyAttributeFlags(std::uint32_t bits, int) HAL_NOEXCEPT
+	: bits__(bits) {
+	}
+	
+	// The enumerators are ordinals, and their bits match the
+	// kJSPropertyAttribute constants: ReadOnly = 1 << 1, DontEnum = 1
+	// << 2 and DontDelete = 1 << 3.
+	static constexpr std::uint32_t ToBits(JSPropertyAttribute attribute) HAL_NOEXCEPT {
+		return attribute == JSPropertyAttribute::None ? 0 : (1u << static_cast<std::uint32_t>(attribute));
+	}
+	
+	std::uint32_t bits__;
+};
+
+inline
+constexpr JSPropertyAttributeFlags operator|(JSPropertyAttribute lhs, JSPropertyAttribute rhs) HAL_NOEXCEPT {
+	return JSPropertyAttributeFlags(lhs) | JSPropertyAttributeFlags(rhs);
+}
+
+} // namespace HAL {
+
 #endif // _HAL_JSPROPERTYATTRIBUTE_HPP_
@@ -153,6 +153,9 @@ namespace HAL {
       friend class JSPropertyNameArray;       // GetNameAtIndex
       friend class JSPropertyNameAccumulator; // AddName
       friend class JSFunction;
+      friend class JSArrayBuilder;            // AppendString
+      friend class JSObjectTemplate;          // property names
+      friend class JSDocumentVisitor;         // VisitString
       
       friend std::vector<JSStringRef> detail::to_vector(const std::vector<JSString>&);
       
@@ -0,0 +1,150 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSTHREADPOOL_HPP_
+#define _HAL_JSTHREADPOOL_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace HAL {
+
+  /*!
+   @class
+
+   @discussion A JSThreadPool runs slow native work, such as
+   compression, hashing or disk access, on native threads so that it
+   doesn't stall the thread that runs a context's scripts.
+
+   Each piece of work posted to the pool comes with a completion. The
+   work runs on one of the pool's threads and must not touch any
+   JavaScript value. Its completion is queued for the thread that owns
+   the pool, which runs it from RunCompletions, and may use the
+   context again, for example to resolve a promise with the result.
+
+   HAL has no run loop of its own, so the host calls RunCompletions
+   from its run loop. A completion callback, if set, is called on the
+   pool thread whenever a completion is queued, so that the host can
+   wake its run loop.
+
+   All of the contexts whose work is posted to a pool must run their
+   scripts on the thread that calls RunCompletions and destroys the
+   pool. Completions that haven't run when the pool is destroyed are
+   discarded, after the work that is already running has finished.
+
+   A JSThreadPool can't be copied.
+   */
+  class HAL_EXPORT JSThreadPool final HAL_PERFORMANCE_COUNTER1(JSThreadPool) {
+
+  public:
+
+    /*!
+     @method
+
+     @abstract Create a pool with thread_count threads.
+
+     @discussion A thread_count of zero uses one thread per hardware
+     thread.
+     */
+    explicit JSThreadPool(std::size_t thread_count = 0);
+
+    /*!
+     @method
+
+     @abstract Run work on a pool thread, then queue completion for
+     RunCompletions.
+
+     @discussion work should not throw; an exception that escapes it
+     is discarded. completion is only run, and destroyed, on the
+     thread that owns the pool.
+     */
+    void Post(std::function<void()> work, std::function<void()> completion);
+
+    /*!
+     @method
+
+     @abstract Run the queued completions on the calling thread.
+
+     @discussion If no completion is queued but work is still
+     outstanding, wait up to timeout for one.
+
+     @result The number of completions that ran.
+
+     @throws The first exception thrown by a completion, after all of
+     them have run.
+     */
+    std::size_t RunCompletions(std::chrono::milliseconds timeout = std::chrono::milliseconds::zero());
+
+    /*!
+     @method
+
+     @abstract Set the function to call on a pool thread whenever a
+     completion is queued.
+     */
+    void SetCompletionCallback(std::function<void()> completion_callback);
+
+    /*!
+     @method
+
+     @abstract Return the number of posted work items whose
+     completions haven't run yet.
+     */
+    std::size_t GetPendingCount() const;
+
+    /*!
+     @method
+
+     @abstract Return the number of threads in the pool.
+     */
+    std::size_t GetThreadCount() const HAL_NOEXCEPT {
+      return threads__.size();
+    }
+
+    ~JSThreadPool()                              HAL_NOEXCEPT;
+    JSThreadPool(const JSThreadPool&)            = delete;
+    JSThreadPool& operator=(const JSThreadPool&) = delete;
+
+  private:
+
+    // A task is moved between the queues by pointer, so its
+    // completion is never moved or destroyed on a pool thread.
+    struct Task {
+      std::function<void()> work;
+      std::function<void()> completion;
+    };
+
+    void Run();
+
+    // Silence 4251 on Windows since private member variables do not
+    // need to be exported from a DLL.
+#pragma warning(push)
+#pragma warning(disable: 4251)
+    mutable std::mutex                 mutex__;
+    std::condition_variable            work_available__;
+    std::condition_variable            completion_available__;
+    std::deque<std::unique_ptr<Task>>  work_queue__;
+    std::deque<std::unique_ptr<Task>>  completion_queue__;
+    std::size_t                        pending_count__ { 0 };
+    bool                               stopping__      { false };
+    std::function<void()>              completion_callback__;
+    std::vector<std::thread>           threads__;
+#pragma warning(pop)
+  };
+
+} // namespace HAL {
+
+#endif // _HAL_JSTHREADPOOL_HPP_
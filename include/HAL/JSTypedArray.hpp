@@ -0,0 +1,224 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_JSTYPEDARRAY_HPP_
+#define _HAL_JSTYPEDARRAY_HPP_
+
+#include "HAL/JSObject.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <typeinfo>
+#include <vector>
+
+namespace HAL { namespace detail {
+
+	/*!
+	 @class
+
+	 @discussion Map a native element type to the JavaScriptCore
+	 typed array type with the same representation. Only the element
+	 types that have a typed array counterpart are specialized.
+	 */
+	template<typename T>
+	struct JSTypedArrayTraits;
+
+	template<> struct JSTypedArrayTraits<int8_t>   { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeInt8Array;    } };
+	template<> struct JSTypedArrayTraits<uint8_t>  { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeUint8Array;   } };
+	template<> struct JSTypedArrayTraits<int16_t>  { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeInt16Array;   } };
+	template<> struct JSTypedArrayTraits<uint16_t> { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeUint16Array;  } };
+	template<> struct JSTypedArrayTraits<int32_t>  { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeInt32Array;   } };
+	template<> struct JSTypedArrayTraits<uint32_t> { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeUint32Array;  } };
+	template<> struct JSTypedArrayTraits<float>    { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeFloat32Array; } };
+	template<> struct JSTypedArrayTraits<double>   { static JSTypedArrayType Type() HAL_NOEXCEPT { return kJSTypedArrayTypeFloat64Array; } };
+
+	// Thin wrappers over the JavaScriptCore typed array C API that
+	// turn JavaScript exceptions into std::runtime_error. They are
+	// shared by every JSTypedArray<T> instantiation.
+	HAL_EXPORT JSTypedArrayType GetTypedArrayType(const JSContext& js_context, JSObjectRef js_object_ref);
+	HAL_EXPORT JSObjectRef      MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, std::size_t length);
+	HAL_EXPORT JSObjectRef      MakeTypedArrayWithArrayBuffer(const JSContext& js_context, JSTypedArrayType type, JSObjectRef js_array_buffer_ref, std::size_t byte_offset, std::size_t length);
+	HAL_EXPORT void*            GetTypedArrayBytesPtr(const JSContext& js_context, JSObjectRef js_object_ref);
+	HAL_EXPORT std::size_t      GetTypedArrayLength(const JSContext& js_context, JSObjectRef js_object_ref);
+	HAL_EXPORT std::size_t      GetTypedArrayByteOffset(const JSContext& js_context, JSObjectRef js_object_ref);
+	HAL_EXPORT JSObjectRef      GetTypedArrayBuffer(const JSContext& js_context, JSObjectRef js_object_ref);
+	HAL_EXPORT void             ThrowInvalidTypedArray(const char* type_name);
+
+}} // namespace HAL { namespace detail {
+
+namespace HAL {
+
+/*!
+  @class
+
+  @discussion A JavaScript typed array whose elements are of the
+  native type T, e.g. JSTypedArray<float> is a Float32Array.
+
+  The elements are accessed in place: data(), begin() and end()
+  return pointers into the typed array's backing store, so reading or
+  writing a JSTypedArray never copies or converts its elements
+  one-by-one. Hoist data() out of tight loops since each call asks
+  JavaScriptCore for the current backing store.
+
+  The only way to create a JSTypedArray is by using the
+  JSContext::CreateTypedArray member function or by converting a
+  JSObject that is a typed array with the same element type.
+*/
+template<typename T>
+class JSTypedArray final : public JSObject HAL_PERFORMANCE_COUNTER2(JSTypedArray<T>) {
+
+public:
+
+	typedef T           value_type;
+	typedef T*          iterator;
+	typedef const T*    const_iterator;
+	typedef std::size_t size_type;
+
+	/*!
+	 @method
+
+	 @abstract Return a pointer to the first element of this typed
+	 array.
+
+	 @result A pointer to the first element of this typed array.
+	 */
+	T* data() const {
+		return static_cast<T*>(detail::GetTypedArrayBytesPtr(get_context(), static_cast<JSObjectRef>(*this)));
+	}
+
+	/*!
+	 @method
+
+	 @abstract Return the number of elements in this typed array.
+
+	 @result The number of elements in this typed array.
+	 */
+	std::size_t size() const {
+		return detail::GetTypedArrayLength(get_context(), static_cast<JSObjectRef>(*this));
+	}
+
+	bool empty() const {
+		return size() == 0;
+	}
+
+	T* begin() const {
+		return data();
+	}
+
+	T* end() const {
+		return data() + size();
+	}
+
+	T& operator[](std::size_t index) const {
+		return data()[index];
+	}
+
+	/*!
+	 @method
+
+	 @abstract Return the offset in bytes of this typed array's first
+	 element from the start of its ArrayBuffer.
+
+	 @result The offset in bytes into the ArrayBuffer.
+	 */
+	std::size_t GetByteOffset() const {
+		return detail::GetTypedArrayByteOffset(get_context(), static_cast<JSObjectRef>(*this));
+	}
+
+	/*!
+	 @method
+
+	 @abstract Return the ArrayBuffer that backs this typed array.
+
+	 @result The ArrayBuffer that backs this typed array.
+	 */
+	JSArrayBuffer GetArrayBuffer() const {
+		const auto js_context = get_context();
+		return JSArrayBuffer(js_context, detail::GetTypedArrayBuffer(js_context, static_cast<JSObjectRef>(*this)));
+	}
+
+	/*!
+	 @method
+
+	 @abstract Copy the elements of this typed array into a
+	 std::vector<T> with a single memcpy.
+
+	 @result A std::vector<T> with a copy of this typed array's
+	 elements.
+	 */
+	operator std::vector<T>() const {
+		const auto length = size();
+		std::vector<T> items(length);
+		if (length > 0) {
+			std::memcpy(items.data(), data(), length * sizeof(T));
+		}
+		return items;
+	}
+
+private:
+
+	// Only JSContext and JSObject can create a JSTypedArray.
+	friend JSContext;
+	friend JSObject;
+
+	// For interoperability with the JavaScriptCore C API.
+	JSTypedArray(const JSContext& js_context, JSObjectRef js_object_ref)
+			: JSObject(js_context, js_object_ref) {
+		if (detail::GetTypedArrayType(js_context, js_object_ref) != detail::JSTypedArrayTraits<T>::Type()) {
+			detail::ThrowInvalidTypedArray(typeid(T).name());
+		}
+	}
+};
+
+typedef JSTypedArray<int8_t>   JSInt8Array;
+typedef JSTypedArray<uint8_t>  JSUint8Array;
+typedef JSTypedArray<int16_t>  JSInt16Array;
+typedef JSTypedArray<uint16_t> JSUint16Array;
+typedef JSTypedArray<int32_t>  JSInt32Array;
+typedef JSTypedArray<uint32_t> JSUint32Array;
+typedef JSTypedArray<float>    JSFloat32Array;
+typedef JSTypedArray<double>   JSFloat64Array;
+
+template<typename T>
+JSObject::operator JSTypedArray<T>() const {
+	return JSTypedArray<T>(js_context__, js_object_ref__);
+}
+
+template<typename T>
+JSTypedArray<T> JSContext::CreateTypedArray(std::size_t length) const {
+	HAL_JSCONTEXT_LOCK_GUARD;
+	const JSContext js_context(js_global_context_ref__);
+	return JSTypedArray<T>(js_context, detail::MakeTypedArray(js_context, detail::JSTypedArrayTraits<T>::Type(), length));
+}
+
+template<typename T>
+JSTypedArray<T> JSContext::CreateTypedArray(const T* values, std::size_t length) const {
+	auto js_typed_array = CreateTypedArray<T>(length);
+	if (length > 0) {
+		std::memcpy(js_typed_array.data(), values, length * sizeof(T));
+	}
+	return js_typed_array;
+}
+
+template<typename T>
+JSTypedArray<T> JSContext::CreateTypedArray(const std::vector<T>& values) const {
+	return CreateTypedArray<T>(values.data(), values.size());
+}
+
+template<typename T>
+JSTypedArray<T> JSContext::CreateTypedArray(const JSArrayBuffer& array_buffer, std::size_t byte_offset, std::size_t length) const {
+	HAL_JSCONTEXT_LOCK_GUARD;
+	const JSContext js_context(js_global_context_ref__);
+	return JSTypedArray<T>(js_context, detail::MakeTypedArrayWithArrayBuffer(js_context, detail::JSTypedArrayTraits<T>::Type(), static_cast<JSObjectRef>(array_buffer), byte_offset, length));
+}
+
+} // namespace HAL {
+
+#endif // _HAL_JSTYPEDARRAY_HPP_
@@ -27,6 +27,9 @@ namespace HAL {
   class JSError;
   class JSRegExp;
   
+  template<typename T>
+  class JSExpected;
+  
   namespace detail {
     template<typename T>
     class JSExportClass;
@@ -168,6 +171,22 @@ namespace HAL {
      */
     explicit operator JSObject() const;
     
+    /*!
+     @method
+     
+     @abstract Convert this JSValue to a JSString, a double or a
+     JSObject without throwing.
+     
+     @discussion A conversion can throw when it calls a toString or
+     valueOf function. Its exception is returned as is, without being
+     thrown or logged.
+     
+     @result The result of conversion, or the exception that it threw.
+     */
+    virtual JSExpected<JSString> TryToString() const final;
+    virtual JSExpected<double>   TryToNumber() const final;
+    virtual JSExpected<JSObject> TryToObject() const final;
+    
     /*!
      @method
      
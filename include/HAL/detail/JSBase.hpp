@@ -50,6 +50,15 @@
 #define HAL_NOEXCEPT
 #endif
 
+// VS 2013 does not support thread_local, but its __declspec(thread)
+// works for variables that need no dynamic initialization or
+// destruction, which is all HAL_THREAD_LOCAL may be used for.
+#if defined(_MSC_VER) && _MSC_VER <= 1800
+#define HAL_THREAD_LOCAL __declspec(thread)
+#else
+#define HAL_THREAD_LOCAL thread_local
+#endif
+
 #ifdef HAL_THREAD_SAFE
 #include <mutex>
 #endif
@@ -0,0 +1,176 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#ifndef _HAL_DETAIL_JSEXPORTASYNCFUNCTION_HPP_
+#define _HAL_DETAIL_JSEXPORTASYNCFUNCTION_HPP_
+
+#include "HAL/detail/JSBase.hpp"
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/JSPromise.hpp"
+#include "HAL/JSThreadPool.hpp"
+
+#include <exception>
+#include <functional>
+#include <memory>
+#include <string>
+#include <tuple>
+#include <type_traits>
+#include <utility>
+
+namespace HAL { namespace detail {
+
+  /*!
+   @class
+
+   @discussion Whether every type is a native type, which can be used
+   on a thread other than the context's.
+   */
+  template<typename... Types>
+  struct JSIsNativeType : std::true_type {
+  };
+
+  template<typename Type, typename... Types>
+  struct JSIsNativeType<Type, Types...> : std::integral_constant<bool,
+  !std::is_base_of<JSValue, typename std::decay<Type>::type>::value &&
+  !std::is_base_of<JSObject, typename std::decay<Type>::type>::value &&
+  JSIsNativeType<Types...>::value> {
+  };
+
+  /*!
+   @class
+
+   @discussion The CallNamedFunctionArgumentsCallback of a function
+   property added by AddAsyncFunctionProperty.
+
+   A call converts its arguments to Args... on the context's thread,
+   like a typed function, and returns a promise right away. The member
+   function runs on the thread pool with its own copy of the
+   arguments, and its result, or the message of the exception it
+   threw, settles the promise from JSThreadPool::RunCompletions.
+
+   The JavaScript object is kept alive until the promise is settled,
+   so the native object can't be finalized while the member function
+   runs.
+   */
+  template<typename T, typename R, typename... Args>
+  class JSExportAsyncFunction final {
+
+    static_assert(JSIsNativeType<R, Args...>::value, "The arguments and result of an async function must be native types, since it runs on a pool thread.");
+
+  public:
+
+    typedef std::function<R(T&, Args...)> Method;
+
+    JSExportAsyncFunction(const Method& method, const std::shared_ptr<JSThreadPool>& thread_pool)
+    : method__(method)
+    , thread_pool__(thread_pool) {
+    }
+
+    JSValue operator()(T& object, const JSArguments& arguments, JSObject& this_object) const {
+      const auto js_context  = arguments.get_context();
+      const auto context_ref = static_cast<JSContextRef>(js_context);
+      auto deferred          = js_context.CreatePromise();
+
+      // Like a JavaScript async function, a bad call rejects the
+      // promise instead of throwing.
+      if (arguments.size() < sizeof...(Args)) {
+        deferred.second.Reject(JSValue(js_context, MakeTypeError(context_ref, "Expected " + std::to_string(sizeof...(Args)) + " arguments but got " + std::to_string(arguments.size()) + ".")));
+        return deferred.first;
+      }
+
+      JSValueRef exception { nullptr };
+      const auto state = std::make_shared<State>(method__, object, ConvertArguments(context_ref, arguments.data(), &exception, Indices()));
+      if (exception) {
+        deferred.second.Reject(JSValue(js_context, exception));
+        return deferred.first;
+      }
+
+      // The completion holds the only JavaScript values, and it is
+      // only run and destroyed on the context's thread. this_object
+      // is captured to keep the native object alive.
+      auto resolver = deferred.second;
+      thread_pool__->Post([state] {
+        try {
+          Run(*state, std::is_void<R>(), Indices());
+        } catch (...) {
+          state->exception = std::current_exception();
+        }
+      }, [state, resolver, this_object]() mutable {
+        if (!state->exception) {
+          Settle(resolver, *state, std::is_void<R>());
+          return;
+        }
+        try {
+          std::rethrow_exception(state->exception);
+        } catch (const std::exception& e) {
+          resolver.Reject(std::string(e.what()));
+        } catch (...) {
+          resolver.Reject(std::string("unknown exception"));
+        }
+      });
+
+      return deferred.first;
+    }
+
+  private:
+
+    typedef std::tuple<typename std::decay<Args>::type...>       Arguments;
+    typedef typename JSMakeIndexSequence<sizeof...(Args)>::type Indices;
+
+    // A void member function has no result to hold.
+    typedef typename std::conditional<std::is_void<R>::value, bool, typename std::decay<R>::type>::type Result;
+
+    // The native state of one call, shared by the work and its
+    // completion.
+    struct State {
+      State(const Method& method, T& object, Arguments&& arguments)
+      : method(method)
+      , object_ptr(&object)
+      , arguments(std::move(arguments)) {
+      }
+
+      Method                  method;
+      T*                      object_ptr;
+      Arguments               arguments;
+      std::unique_ptr<Result> result;
+      std::exception_ptr      exception;
+    };
+
+    template<std::size_t... Is>
+    static Arguments ConvertArguments(JSContextRef context_ref, const JSValueRef arguments_array[], JSValueRef* exception, JSIndexSequence<Is...>) {
+      // Braced initializers are evaluated in order, so the first type
+      // mismatch is the one reported.
+      return Arguments { JSTypedArgument<typename std::decay<Args>::type>::Convert(context_ref, arguments_array[Is], Is, exception)... };
+    }
+
+    template<std::size_t... Is>
+    static void Run(State& state, std::false_type, JSIndexSequence<Is...>) {
+      state.result.reset(new Result(state.method(*state.object_ptr, std::move(std::get<Is>(state.arguments))...)));
+    }
+
+    template<std::size_t... Is>
+    static void Run(State& state, std::true_type, JSIndexSequence<Is...>) {
+      state.method(*state.object_ptr, std::move(std::get<Is>(state.arguments))...);
+    }
+
+    static void Settle(JSPromiseResolver& resolver, const State& state, std::false_type) {
+      resolver.Resolve(*state.result);
+    }
+
+    static void Settle(JSPromiseResolver& resolver, const State&, std::true_type) {
+      resolver.Resolve();
+    }
+
+    Method                        method__;
+    std::shared_ptr<JSThreadPool> thread_pool__;
+  };
+
+}} // namespace HAL { namespace detail {
+
+#endif // _HAL_DETAIL_JSEXPORTASYNCFUNCTION_HPP_
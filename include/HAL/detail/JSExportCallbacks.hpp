@@ -17,6 +17,7 @@ namespace HAL {
   class JSString;
   class JSObject;
   class JSPropertyNameAccumulator;
+  class JSArguments;
 }
 
 
@@ -106,6 +107,28 @@ namespace HAL { namespace detail {
   template<typename T>
   using CallNamedFunctionCallback = std::function<JSValue(T&, const std::vector<JSValue>&, JSObject&)>;
   
+  /*!
+   @typedef CallNamedFunctionArgumentsCallback
+   
+   @abstract The callback to invoke when your JavaScript object is
+   called as a function, given a JSArguments view of the arguments
+   instead of a std::vector<JSValue>.
+   
+   @discussion The arguments are neither copied nor protected, so
+   this is the cheaper form for small, getter-like functions. For
+   example, given this class definition:
+   
+   class Foo {
+   JSValue Add(const JSArguments& arguments, JSObject& this_object);
+   };
+   
+   You would add the function property like this:
+   
+   AddFunctionProperty("add", &Foo::Add);
+   */
+  template<typename T>
+  using CallNamedFunctionArgumentsCallback = std::function<JSValue(T&, const JSArguments&, JSObject&)>;
+  
   /*!
    @typedef HasPropertyCallback
    
@@ -19,6 +19,7 @@
 #include "HAL/JSNumber.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArguments.hpp"
 
 #include "HAL/detail/JSPropertyNameAccumulator.hpp"
 #include "HAL/detail/JSUtil.hpp"
@@ -406,13 +407,6 @@ namespace HAL { namespace detail {
     JSObject          js_object(JSObject::FindJSObject(context_ref, function_ref));
     JSObject          this_object(JSObject::FindJSObject(context_ref, this_object_ref));
     const std::string function_name = static_cast<std::string>(js_object.GetProperty("name"));
-    
-    const auto native_name = GetJSExportComponentName(function_name);
-    JSError::NativeStack__.push_back(native_name);
-
-    if (JSError::NativeStack__.size() > 10) {
-      JSError::NativeStack__.pop_front();
-    }
 
     // precondition
     assert(js_object.IsFunction());
@@ -426,13 +420,18 @@ namespace HAL { namespace detail {
     // precondition
     assert(callback_found);
 
+    // The frame names the key of the callback map, which lives as long
+    // as the class, and is popped after the error for an exception has
+    // been created.
+    const JSError::NativeStackFrame native_stack_frame(typeid(T).name(), (callback_position -> first).c_str());
+
     try {
-      const auto callback = (callback_position -> second).function_callback();
-      const auto result   = callback(*native_this_ptr, to_vector(this_object.get_context(), argument_count, arguments_array), this_object);
-      
-      if (!JSError::NativeStack__.empty()) {
-        JSError::NativeStack__.pop_back();
-      }
+      // A callback that takes a JSArguments is given the raw
+      // arguments without copying or protecting them.
+      const auto arguments_callback = (callback_position -> second).arguments_callback();
+      const auto result = arguments_callback
+          ? arguments_callback(*native_this_ptr, JSArguments(context_ref, argument_count, arguments_array), this_object)
+          : (callback_position -> second).function_callback()(*native_this_ptr, to_vector(this_object.get_context(), argument_count, arguments_array), this_object);
 
 #ifdef HAL_LOGGING_ENABLE
       std::string js_value_str;
@@ -12,6 +12,7 @@
 #include "HAL/detail/JSBase.hpp"
 #include "HAL/detail/JSExportClassDefinition.hpp"
 #include "HAL/detail/JSExportClass.hpp"
+#include "HAL/detail/JSExportAsyncFunction.hpp"
 #include "HAL/detail/JSUtil.hpp"
 
 #include <string>
@@ -251,9 +252,9 @@ namespace HAL { namespace detail {
      @result A reference to the builder for chaining.
      */
     JSExportClassDefinitionBuilder<T>& AddValueProperty(const JSString& property_name, GetNamedValuePropertyCallback<T> get_callback, SetNamedValuePropertyCallback<T> set_callback = nullptr, bool enumerable = true) {
-      std::unordered_set<JSPropertyAttribute> attributes { JSPropertyAttribute::DontDelete };
-      static_cast<void>(!enumerable   && attributes.insert(JSPropertyAttribute::DontEnum).second);
-      static_cast<void>(!set_callback && attributes.insert(JSPropertyAttribute::ReadOnly).second);
+      JSPropertyAttributeFlags attributes = JSPropertyAttribute::DontDelete;
+      static_cast<void>(!enumerable   && attributes.insert(JSPropertyAttribute::DontEnum));
+      static_cast<void>(!set_callback && attributes.insert(JSPropertyAttribute::ReadOnly));
       HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
       AddValuePropertyCallback(JSExportNamedValuePropertyCallback<T>(property_name, get_callback, set_callback, attributes));
       return *this;
@@ -305,8 +306,8 @@ namespace HAL { namespace detail {
      @result A reference to the builder for chaining.
      */
     JSExportClassDefinitionBuilder<T>& AddConstantProperty(const JSString& property_name, GetNamedValuePropertyCallback<T> get_callback, bool enumerable = true) {
-      std::unordered_set<JSPropertyAttribute> attributes { JSPropertyAttribute::DontDelete, JSPropertyAttribute::ReadOnly };
-      static_cast<void>(!enumerable   && attributes.insert(JSPropertyAttribute::DontEnum).second);
+      JSPropertyAttributeFlags attributes = JSPropertyAttribute::DontDelete | JSPropertyAttribute::ReadOnly;
+      static_cast<void>(!enumerable   && attributes.insert(JSPropertyAttribute::DontEnum));
       HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
       AddConstantPropertyCallback(JSExportNamedValuePropertyCallback<T>(property_name, get_callback, nullptr, attributes));
       return *this;
@@ -345,13 +346,98 @@ namespace HAL { namespace detail {
      @result A reference to the builder for chaining.
      */
     JSExportClassDefinitionBuilder<T>& AddFunctionProperty(const JSString& function_name, CallNamedFunctionCallback<T> function_callback, bool enumerable = true) {
-      std::unordered_set<JSPropertyAttribute> attributes { JSPropertyAttribute::None };
-      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum).second);
+      JSPropertyAttributeFlags attributes = JSPropertyAttribute::None;
+      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum));
       HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
       AddFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback<T>(function_name, function_callback, attributes));
       return *this;
     }
     
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     member function is given a JSArguments view of its arguments
+     instead of a std::vector<JSValue>.
+     
+     @discussion For example, given this class definition:
+     
+     class Foo {
+     JSValue Add(const JSArguments& arguments, JSObject& this_object);
+     };
+     
+     You would call the builer like this:
+     
+     builder.AddFunctionProperty("add", &Foo::Add);
+     
+     @throws std::invalid_argument exception under these preconditions:
+     
+     1. If function_name is empty.
+     
+     2. If method is null.
+     
+     @result A reference to the builder for chaining.
+     */
+    JSExportClassDefinitionBuilder<T>& AddFunctionProperty(const JSString& function_name, JSValue (T::*method)(const JSArguments&, JSObject&), bool enumerable = true) {
+      JSPropertyAttributeFlags attributes = JSPropertyAttribute::None;
+      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum));
+      const CallNamedFunctionArgumentsCallback<T> arguments_callback = method ? CallNamedFunctionArgumentsCallback<T>(method) : nullptr;
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      AddFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback<T>(function_name, arguments_callback, attributes));
+      return *this;
+    }
+    
+    /*!
+     @method
+     
+     @abstract Add a function property to your JavaScript object whose
+     member function runs on a native thread pool and whose result
+     resolves a JavaScript Promise.
+     
+     @discussion The arguments are converted to native values on the
+     context's thread, like the arguments of a typed function, and the
+     member function is called with its own copy of them on a pool
+     thread, so it must not use any JavaScript value. Its result, or
+     the message of the exception it threw, settles the promise when
+     the host calls thread_pool->RunCompletions. For example, given
+     this class definition:
+     
+     class Foo {
+     std::string Compress(const std::string& text);
+     };
+     
+     You would call the builer like this:
+     
+     builder.AddAsyncFunctionProperty("compress", &Foo::Compress, thread_pool);
+     
+     @throws std::invalid_argument exception under these preconditions:
+     
+     1. If function_name is empty.
+     
+     2. If method or thread_pool is null.
+     
+     @result A reference to the builder for chaining.
+     */
+    template<typename R, typename... Args>
+    JSExportClassDefinitionBuilder<T>& AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...), const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable = true) {
+      return AddAsyncFunctionProperty<R, Args...>(function_name, method ? std::function<R(T&, Args...)>(method) : nullptr, thread_pool, enumerable);
+    }
+    
+    template<typename R, typename... Args>
+    JSExportClassDefinitionBuilder<T>& AddAsyncFunctionProperty(const JSString& function_name, R (T::*method)(Args...) const, const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable = true) {
+      return AddAsyncFunctionProperty<R, Args...>(function_name, method ? std::function<R(T&, Args...)>(method) : nullptr, thread_pool, enumerable);
+    }
+    
+    template<typename R, typename... Args>
+    JSExportClassDefinitionBuilder<T>& AddAsyncFunctionProperty(const JSString& function_name, const std::function<R(T&, Args...)>& method, const std::shared_ptr<JSThreadPool>& thread_pool, bool enumerable = true) {
+      JSPropertyAttributeFlags attributes = JSPropertyAttribute::None;
+      static_cast<void>(!enumerable && attributes.insert(JSPropertyAttribute::DontEnum));
+      const CallNamedFunctionArgumentsCallback<T> arguments_callback = method && thread_pool ? CallNamedFunctionArgumentsCallback<T>(JSExportAsyncFunction<T, R, Args...>(method, thread_pool)) : nullptr;
+      HAL_DETAIL_JSEXPORTCLASSDEFINITIONBUILDER_LOCK_GUARD;
+      AddFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback<T>(function_name, arguments_callback, attributes));
+      return *this;
+    }
+    
     /*!
      @method
      
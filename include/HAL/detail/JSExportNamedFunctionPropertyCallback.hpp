@@ -56,7 +56,7 @@ namespace HAL { namespace detail {
      @param function_callback The callback to invoke when calling
      the JavaScript object as a function.
      
-     @param attributes The set of JSPropertyAttributes to give to
+     @param attributes The JSPropertyAttributes to give to
      the function property.
      
      @result The callback to invoke when a JavaScript object is
@@ -71,12 +71,33 @@ namespace HAL { namespace detail {
      */
     JSExportNamedFunctionPropertyCallback(const std::string& function_name,
                                           CallNamedFunctionCallback<T> function_callback,
-                                          const std::unordered_set<JSPropertyAttribute>& attributes);
+                                          JSPropertyAttributeFlags attributes);
+    
+    /*!
+     @method
+     
+     @abstract Create a callback to invoke with a JSArguments view of
+     the arguments when a JavaScript object is called as a function.
+     
+     @throws std::invalid_argument exception under these
+     preconditions:
+     
+     1. If function_name is empty.
+     
+     2. If the arguments_callback is not provided.
+     */
+    JSExportNamedFunctionPropertyCallback(const std::string& function_name,
+                                          CallNamedFunctionArgumentsCallback<T> arguments_callback,
+                                          JSPropertyAttributeFlags attributes);
     
     CallNamedFunctionCallback<T> function_callback() const {
       return function_callback__;
     }
     
+    CallNamedFunctionArgumentsCallback<T> arguments_callback() const {
+      return arguments_callback__;
+    }
+    
     ~JSExportNamedFunctionPropertyCallback()                                                       = default;
     JSExportNamedFunctionPropertyCallback(const JSExportNamedFunctionPropertyCallback&)            HAL_NOEXCEPT;
     JSExportNamedFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback&&)                 HAL_NOEXCEPT;
@@ -89,14 +110,15 @@ namespace HAL { namespace detail {
     template<typename U>
     friend bool operator==(const JSExportNamedFunctionPropertyCallback<U>& lhs, const JSExportNamedFunctionPropertyCallback<U>& rhs) HAL_NOEXCEPT;
     
-    CallNamedFunctionCallback<T> function_callback__ { nullptr };
+    CallNamedFunctionCallback<T>          function_callback__  { nullptr };
+    CallNamedFunctionArgumentsCallback<T> arguments_callback__ { nullptr };
   };
   
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(
                                                                                   const std::string& function_name,
                                                                                   CallNamedFunctionCallback<T> function_callback,
-                                                                                  const std::unordered_set<JSPropertyAttribute>& attributes)
+                                                                                  JSPropertyAttributeFlags attributes)
   : JSPropertyCallback(function_name, attributes)
   , function_callback__(function_callback) {
     
@@ -105,23 +127,39 @@ namespace HAL { namespace detail {
     }
   }
   
+  template<typename T>
+  JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(
+                                                                                  const std::string& function_name,
+                                                                                  CallNamedFunctionArgumentsCallback<T> arguments_callback,
+                                                                                  JSPropertyAttributeFlags attributes)
+  : JSPropertyCallback(function_name, attributes)
+  , arguments_callback__(arguments_callback) {
+    
+    if (!arguments_callback) {
+      ThrowInvalidArgument("JSExportNamedFunctionPropertyCallback", "arguments_callback is missing");
+    }
+  }
+  
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(const JSExportNamedFunctionPropertyCallback& rhs) HAL_NOEXCEPT
   : JSPropertyCallback(rhs)
-  , function_callback__(rhs.function_callback__) {
+  , function_callback__(rhs.function_callback__)
+  , arguments_callback__(rhs.arguments_callback__) {
   }
   
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>::JSExportNamedFunctionPropertyCallback(JSExportNamedFunctionPropertyCallback&& rhs) HAL_NOEXCEPT
   : JSPropertyCallback(rhs)
-  , function_callback__(std::move(rhs.function_callback__)) {
+  , function_callback__(std::move(rhs.function_callback__))
+  , arguments_callback__(std::move(rhs.arguments_callback__)) {
   }
   
   template<typename T>
   JSExportNamedFunctionPropertyCallback<T>& JSExportNamedFunctionPropertyCallback<T>::operator=(const JSExportNamedFunctionPropertyCallback<T>& rhs) HAL_NOEXCEPT {
     HAL_DETAIL_JSPROPERTYCALLBACK_LOCK_GUARD;
     JSPropertyCallback::operator=(rhs);
-    function_callback__ = rhs.function_callback__;
+    function_callback__  = rhs.function_callback__;
+    arguments_callback__ = rhs.arguments_callback__;
     return *this;
   }
   
@@ -140,7 +178,8 @@ namespace HAL { namespace detail {
     
     // By swapping the members of two classes, the two classes are
     // effectively swapped.
-    swap(function_callback__, other.function_callback__);
+    swap(function_callback__ , other.function_callback__);
+    swap(arguments_callback__, other.arguments_callback__);
   }
   
   template<typename T>
@@ -160,6 +199,14 @@ namespace HAL { namespace detail {
       return false;
     }
     
+    if (lhs.arguments_callback__ && !rhs.arguments_callback__) {
+      return false;
+    }
+    
+    if (!lhs.arguments_callback__ && rhs.arguments_callback__) {
+      return false;
+    }
+    
     return static_cast<JSPropertyCallback>(lhs) == static_cast<JSPropertyCallback>(rhs);
   }
   
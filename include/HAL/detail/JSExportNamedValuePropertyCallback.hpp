@@ -43,7 +43,7 @@ namespace HAL { namespace detail {
      property's value on a JavaScript object. This may be nullptr,
      in which case the ReadOnly attribute is automatically set.
      
-     @param attributes The set of JSPropertyAttributes to give to
+     @param attributes The JSPropertyAttributes to give to
      the value property.
      
      @result An object which describes a JavaScript value property.
@@ -64,7 +64,7 @@ namespace HAL { namespace detail {
     JSExportNamedValuePropertyCallback(const std::string& property_name,
                                        GetNamedValuePropertyCallback<T> get_callback,
                                        SetNamedValuePropertyCallback<T> set_callback,
-                                       const std::unordered_set<JSPropertyAttribute>& attributes);
+                                       JSPropertyAttributeFlags attributes);
     
     GetNamedValuePropertyCallback<T> get_callback() const HAL_NOEXCEPT {
       return get_callback__;
@@ -95,7 +95,7 @@ namespace HAL { namespace detail {
                                                                             const std::string& property_name,
                                                                             GetNamedValuePropertyCallback<T> get_callback,
                                                                             SetNamedValuePropertyCallback<T> set_callback,
-                                                                            const std::unordered_set<JSPropertyAttribute>& attributes)
+                                                                            JSPropertyAttributeFlags attributes)
   : JSPropertyCallback(property_name, attributes)
   , get_callback__(get_callback)
   , set_callback__(set_callback) {
@@ -104,7 +104,7 @@ namespace HAL { namespace detail {
       ThrowInvalidArgument("JSExportNamedValuePropertyCallback", "Both get_callback and set_callback are missing. At least one callback must be provided");
     }
     
-    if (attributes.find(JSPropertyAttribute::ReadOnly) != attributes.end()) {
+    if (attributes.contains(JSPropertyAttribute::ReadOnly)) {
       if (!get_callback) {
         ThrowInvalidArgument("JSExportNamedValuePropertyCallback", "ReadOnly attribute is set but get_callback is missing");
       }
@@ -13,7 +13,6 @@
 #include "HAL/JSPropertyAttribute.hpp"
 
 #include <string>
-#include <unordered_set>
 
 namespace HAL { namespace detail {
   
@@ -35,21 +34,21 @@ namespace HAL { namespace detail {
      
      @param name The property's name.
      
-     @param attributes The set of JSPropertyAttributes to give to
-     the property.
+     @param attributes The JSPropertyAttributes to give to the
+     property.
      
      @result An object which describes the name and property
      attributes a JavaScript property.
      
      @throws std::invalid_argument if property_name is empty.
      */
-    JSPropertyCallback(const std::string& name, const std::unordered_set<JSPropertyAttribute, std::hash<JSPropertyAttribute>>& attributes);
+    JSPropertyCallback(const std::string& name, JSPropertyAttributeFlags attributes);
     
     virtual std::string get_name() const HAL_NOEXCEPT final {
       return name__;
     }
     
-    virtual std::unordered_set<JSPropertyAttribute> get_attributes() const HAL_NOEXCEPT final {
+    virtual JSPropertyAttributeFlags get_attributes() const HAL_NOEXCEPT final {
       return attributes__;
     }
     
@@ -77,7 +76,7 @@ namespace HAL { namespace detail {
     // need to be exported from a DLL.
 #pragma warning(push)
 #pragma warning(disable: 4251)
-    std::unordered_set<JSPropertyAttribute> attributes__;
+    JSPropertyAttributeFlags attributes__;
 #pragma warning(pop)
     
 #undef HAL_DETAIL_JSPROPERTYCALLBACK_LOCK_GUARD
@@ -35,37 +35,40 @@ namespace HAL { namespace detail {
     return std::unique_ptr<T>(new T(std::forward<Ts>(params)...));
   }
 
+  /*!
+   @class
+   
+   @discussion The exception thrown when a JavaScript Error crosses
+   into C++.
+   
+   It only holds the protected Error and where the script was
+   evaluated. what() and the js_ accessors read the Error's properties
+   the first time one of them is called, so code that just catches and
+   retries doesn't pay for building strings. They must be called while
+   the Error's context is alive, on the thread that runs its scripts.
+   Copies of the exception share the properties once they are read.
+   */
   class js_runtime_error : public std::runtime_error {
   public:
-    js_runtime_error() HAL_NOEXCEPT = default;
-    js_runtime_error(const JSError& js_error);
+    js_runtime_error(const JSObject& js_error, const std::string& source_url = "", int line_number = 0);
     virtual ~js_runtime_error() = default;
 
-    std::string js_name() const {
-      return js_name__;
-    }
-    std::string js_message() const {
-      return js_message__;
-    }
-    std::string js_filename() const {
-      return js_filename__;
-    }
-    std::uint32_t js_linenumber() const {
-      return js_linenumber__;
-    }
-    std::string js_stack() const {
-      return js_stack__;
-    }
-    std::string js_nativeStack() const {
-      return js_nativeStack__;
-    }
+    virtual const char* what() const HAL_NOEXCEPT override;
+
+    // The JavaScript Error, untouched.
+    JSObject js_error() const;
+
+    std::string js_name() const;
+    std::string js_message() const;
+    std::string js_filename() const;
+    std::uint32_t js_linenumber() const;
+    std::string js_stack() const;
+    std::string js_nativeStack() const;
   private:
-    std::string js_name__;
-    std::string js_message__;
-    std::string js_filename__;
-    std::uint32_t js_linenumber__;
-    std::string js_stack__;
-    std::string js_nativeStack__;
+    struct Properties;
+    const Properties& GetProperties() const HAL_NOEXCEPT;
+
+    std::shared_ptr<Properties> properties__;
   };
 
   HAL_EXPORT void    ThrowRuntimeError(const std::string& internal_component_name, const std::string& message);
@@ -85,6 +88,14 @@ namespace HAL { namespace detail {
   HAL_EXPORT std::unordered_set<JSPropertyAttribute> FromJSPropertyAttributes(::JSPropertyAttributes attributes) HAL_NOEXCEPT;
   HAL_EXPORT std::string to_string(JSPropertyAttribute)                                                          HAL_NOEXCEPT;
   HAL_EXPORT std::string to_string(const std::unordered_set<JSPropertyAttribute>& attributes)                    HAL_NOEXCEPT;
+  HAL_EXPORT std::string to_string(JSPropertyAttributeFlags attributes)                                          HAL_NOEXCEPT;
+  
+  // The bits of a JSPropertyAttributeFlags are the JavaScriptCore
+  // JSPropertyAttributes, so this conversion is free.
+  inline
+  constexpr unsigned ToJSPropertyAttributes(JSPropertyAttributeFlags attributes) HAL_NOEXCEPT {
+    return attributes.bits();
+  }
   HAL_EXPORT std::string to_string_JSPropertyAttributes(::JSPropertyAttributes attributes)                       HAL_NOEXCEPT;
   
   HAL_EXPORT unsigned ToJSClassAttribute(JSClassAttribute attribute)                                             HAL_NOEXCEPT;
@@ -103,6 +114,35 @@ namespace HAL { namespace detail {
   // representation.
   HAL_EXPORT int32_t to_int32_t(double number);
   
+  // Parse a property name as a canonical array index, i.e. the
+  // decimal string of an integer in [0, 2^32 - 2] without leading
+  // zeros, as defined in section 15.4 of the ECMA-262 spec. The
+  // UTF-16 characters are read in place, so no std::string or
+  // JSString is created.
+  HAL_EXPORT bool to_array_index(JSStringRef property_name, uint32_t& index) HAL_NOEXCEPT;
+  
+  // Convert a value to a bool like static_cast<bool>(JSValue), i.e.
+  // by ToBoolean, except that the strings "true" and "false" convert
+  // to true and false when HAL_USE_STRING_BOOLEAN_CONVERSION is
+  // defined. That option only applies to HAL's own sources, so
+  // headers must call this rather than JSValueToBoolean.
+  HAL_EXPORT bool to_bool(JSContextRef context_ref, JSValueRef js_value_ref) HAL_NOEXCEPT;
+  
+  // Create the JSClass of native functions, whose objects are called
+  // by call_as_function and finalized by finalize. Like the empty
+  // JSClass, a class is meant to be created once, e.g. in a
+  // function-local static, and is never released since it is
+  // immutable and shared by every context.
+  HAL_EXPORT JSClassRef CreateFunctionClass(JSObjectCallAsFunctionCallback call_as_function, JSObjectFinalizeCallback finalize = nullptr) HAL_NOEXCEPT;
+  
+  // A JSObjectFinalizeCallback that deletes the object's private
+  // data, which was allocated by new T.
+  template<typename T>
+  void DeletePrivateData(JSObjectRef object_ref) {
+    delete static_cast<T*>(JSObjectGetPrivate(object_ref));
+    JSObjectSetPrivate(object_ref, nullptr);
+  }
+  
 }} // namespace HAL { namespace detail {
 
 #endif // _HAL_DETAIL_JSUTIL_HPP_
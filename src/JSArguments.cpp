@@ -0,0 +1,92 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSArguments.hpp"
+#include "HAL/JSContext.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+namespace HAL {
+
+  JSContext JSArguments::get_context() const HAL_NOEXCEPT {
+    return JSContext(context_ref__);
+  }
+
+  JSValueRef JSArguments::GetJSValueRef(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ ? arguments__[index] : JSValueMakeUndefined(context_ref__);
+  }
+
+  JSValue JSArguments::operator[](std::size_t index) const HAL_NOEXCEPT {
+    return JSValue(get_context(), GetJSValueRef(index));
+  }
+
+  std::vector<JSValue> JSArguments::to_vector() const {
+    return detail::to_vector(get_context(), count__, arguments__);
+  }
+
+  bool JSArguments::IsUndefined(std::size_t index) const HAL_NOEXCEPT {
+    return index >= count__ || JSValueIsUndefined(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::IsNull(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && JSValueIsNull(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::IsBoolean(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && JSValueIsBoolean(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::IsNumber(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && JSValueIsNumber(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::IsString(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && JSValueIsString(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::IsObject(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && JSValueIsObject(context_ref__, arguments__[index]);
+  }
+
+  bool JSArguments::ToBoolean(std::size_t index) const HAL_NOEXCEPT {
+    return index < count__ && detail::to_bool(context_ref__, arguments__[index]);
+  }
+
+  double JSArguments::ToNumber(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    const double result = JSValueToNumber(context_ref__, GetJSValueRef(index), &exception);
+
+    if (exception) {
+      detail::ThrowRuntimeError("JSArguments", JSValue(get_context(), exception));
+    }
+
+    return result;
+  }
+
+  int32_t JSArguments::ToInt32(std::size_t index) const {
+    return detail::to_int32_t(ToNumber(index));
+  }
+
+  uint32_t JSArguments::ToUInt32(std::size_t index) const {
+    // ToUint32 and ToInt32 agree modulo 2^32.
+    return static_cast<uint32_t>(detail::to_int32_t(ToNumber(index)));
+  }
+
+  std::string JSArguments::ToString(std::size_t index) const {
+    JSValueRef exception { nullptr };
+    auto string = detail::ToStdString(context_ref__, GetJSValueRef(index), &exception);
+
+    if (exception) {
+      detail::ThrowRuntimeError("JSArguments", JSValue(get_context(), exception));
+    }
+
+    return string;
+  }
+
+} // namespace HAL {
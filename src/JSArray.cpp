@@ -9,11 +9,18 @@
 #include "HAL/JSArray.hpp"
 #include "HAL/JSValue.hpp"
 #include "HAL/JSString.hpp"
+#include "HAL/JSTypedArray.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/JSClass.hpp"
 #include "HAL/detail/JSUtil.hpp"
 #include <vector>
 #include <algorithm>
 #include <stdexcept>
 #include <cassert>
+#include <cmath>
+#include <cstring>
+#include <limits>
+#include <string>
 
 namespace HAL {
 
@@ -56,6 +63,51 @@ uint32_t JSArray::GetLength() const HAL_NOEXCEPT {
 	return static_cast<uint32_t>(length);
 }
 
+JSArray::const_iterator JSArray::begin() const HAL_NOEXCEPT {
+	return const_iterator(this, 0);
+}
+
+JSArray::const_iterator JSArray::end() const HAL_NOEXCEPT {
+	return const_iterator(this, GetLength());
+}
+
+std::size_t JSArray::ForEachChunk(std::size_t chunk_size, const std::function<bool(uint32_t first_index, const std::vector<JSValue>& chunk)>& callback) const {
+	const auto length      = GetLength();
+	const auto js_context  = get_context();
+	const auto context_ref = static_cast<JSContextRef>(js_context);
+	const auto object_ref  = static_cast<JSObjectRef>(*this);
+	chunk_size = std::max<std::size_t>(chunk_size, 1);
+
+	std::vector<JSValue> chunk;
+	chunk.reserve(std::min<std::size_t>(chunk_size, length));
+
+	uint32_t index = 0;
+	while (index < length) {
+		const auto first_index = index;
+		const auto chunk_end   = static_cast<uint32_t>(std::min<std::size_t>(length, first_index + chunk_size));
+		for (; index < chunk_end; ++index) {
+			JSValueRef exception { nullptr };
+			JSValueRef js_value_ref = JSObjectGetPropertyAtIndex(context_ref, object_ref, index, &exception);
+			if (exception) {
+				detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+			}
+			chunk.push_back(JSValue(js_context, js_value_ref));
+		}
+
+		const bool keep_going = callback(first_index, chunk);
+
+		// Unprotect this chunk before fetching the next one but keep the
+		// buffer's capacity.
+		chunk.clear();
+
+		if (!keep_going) {
+			break;
+		}
+	}
+
+	return index;
+}
+
 JSArray::operator std::vector<JSValue>() const {
 	const auto length = GetLength();
 	std::vector<JSValue> items;
@@ -67,11 +119,22 @@ JSArray::operator std::vector<JSValue>() const {
 }
 
 JSArray::operator std::vector<bool>() const {
-	const auto length = GetLength();
+	const auto length      = GetLength();
+	const auto js_context  = get_context();
+	const auto context_ref = static_cast<JSContextRef>(js_context);
+	const auto object_ref  = static_cast<JSObjectRef>(*this);
+
+	// Convert the raw values in place, without a protected JSValue per
+	// element, by the same rule as static_cast<bool>(JSValue).
 	std::vector<bool> items;
 	items.reserve(length);
 	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<bool>(GetProperty(i)));
+		JSValueRef exception { nullptr };
+		JSValueRef js_value_ref = JSObjectGetPropertyAtIndex(context_ref, object_ref, i, &exception);
+		if (exception) {
+			detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+		}
+		items.push_back(detail::to_bool(context_ref, js_value_ref));
 	}
 	return items;
 }
@@ -87,34 +150,129 @@ JSArray::operator std::vector<std::string>() const {
 }
 
 JSArray::operator std::vector<double>() const {
-	const auto length = GetLength();
-	std::vector<double> items;
-	items.reserve(length);
-	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<double>(GetProperty(i)));
-	}
-	return items;
+	return CopyToFloat64();
 }
 
 JSArray::operator std::vector<int32_t>() const {
-	const auto length = GetLength();
-	std::vector<int32_t> items;
-	items.reserve(length);
-	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<int32_t>(GetProperty(i)));
-	}
+	const auto numbers = CopyToFloat64();
+	std::vector<int32_t> items(numbers.size());
+	std::transform(numbers.begin(), numbers.end(), items.begin(), detail::to_int32_t);
 	return items;
 }
 
 JSArray::operator std::vector<uint32_t>() const {
-	const auto length = GetLength();
-	std::vector<uint32_t> items;
-	items.reserve(length);
-	for (uint32_t i = 0; i < length; i++) {
-		items.push_back(static_cast<uint32_t>(GetProperty(i)));
-	}
+	// As commented in the spec, the operation of ToInt32 and ToUint32
+	// only differ in how the result is interpreted; see NOTEs in
+	// sections 9.5 and 9.6.
+	const auto numbers = CopyToFloat64();
+	std::vector<uint32_t> items(numbers.size());
+	std::transform(numbers.begin(), numbers.end(), items.begin(), [](double number) {
+		return static_cast<uint32_t>(detail::to_int32_t(number));
+	});
 	return items;
 }
 
+void JSArray::CopyNumbersTo(std::vector<double>& values) const {
+	values = CopyNumbersToFloat64();
+}
+
+void JSArray::CopyNumbersTo(std::vector<int32_t>& values) const {
+	const auto numbers = CopyNumbersToFloat64();
+	values.resize(numbers.size());
+	for (std::size_t i = 0; i < numbers.size(); ++i) {
+		const auto number = numbers[i];
+		if (number != std::trunc(number) || number < std::numeric_limits<int32_t>::min() || number > std::numeric_limits<int32_t>::max()) {
+			detail::ThrowInvalidArgument("JSArray", "Element " + std::to_string(i) + " of this JavaScript array is not an int32_t.");
+		}
+		values[i] = static_cast<int32_t>(number);
+	}
+}
+
+void JSArray::CopyNumbersTo(std::vector<uint32_t>& values) const {
+	const auto numbers = CopyNumbersToFloat64();
+	values.resize(numbers.size());
+	for (std::size_t i = 0; i < numbers.size(); ++i) {
+		const auto number = numbers[i];
+		if (number != std::trunc(number) || number < 0 || number > std::numeric_limits<uint32_t>::max()) {
+			detail::ThrowInvalidArgument("JSArray", "Element " + std::to_string(i) + " of this JavaScript array is not an uint32_t.");
+		}
+		values[i] = static_cast<uint32_t>(number);
+	}
+}
+
+std::vector<double> JSArray::CopyToFloat64() const {
+	const auto js_context = get_context();
+	auto js_float64_array = js_context.CreateTypedArray<double>(GetLength());
+	if (js_float64_array.empty()) {
+		return std::vector<double>();
+	}
+
+	// Float64Array.prototype.set applies ToNumber to every element,
+	// which matches static_cast<double>(JSValue), including NaN for
+	// holes.
+	const auto global_object     = js_context.get_global_object();
+	const auto float64_array     = static_cast<JSObject>(global_object.GetProperty("Float64Array"));
+	const auto float64_prototype = static_cast<JSObject>(float64_array.GetProperty("prototype"));
+	auto set                     = static_cast<JSObject>(float64_prototype.GetProperty("set"));
+	set(std::vector<JSValue>{*this}, js_float64_array);
+
+	return static_cast<std::vector<double>>(js_float64_array);
+}
+
+std::vector<double> JSArray::CopyNumbersToFloat64() const {
+	const auto js_context = get_context();
+	auto js_float64_array = js_context.CreateTypedArray<double>(GetLength());
+	if (js_float64_array.empty()) {
+		return std::vector<double>();
+	}
+
+	// JavaScriptCore caches the compiled function by its source, so
+	// only the first call in a context pays to parse it.
+	auto copy_numbers = js_context.CreateFunction(
+	    "for (var i = 0, n = typed.length; i < n; ++i) {"
+	    "  if (!(i in array) || typeof array[i] !== 'number') { return i; }"
+	    "  typed[i] = array[i];"
+	    "}"
+	    "return -1;",
+	    {"array", "typed"});
+
+	const auto invalid_index = static_cast<int32_t>(copy_numbers(std::vector<JSValue>{*this, js_float64_array}, js_context.get_global_object()));
+	if (invalid_index >= 0) {
+		const auto reason = HasProperty(std::to_string(invalid_index)) ? "is not a number." : "is a hole.";
+		detail::ThrowInvalidArgument("JSArray", "Element " + std::to_string(invalid_index) + " of this JavaScript array " + reason);
+	}
+
+	return static_cast<std::vector<double>>(js_float64_array);
+}
+
+void JSArray::GetPrivateData(const JSClass& js_class, uint32_t first_index, void* private_data[], std::size_t count) const {
+	const auto js_context   = get_context();
+	const auto context_ref  = static_cast<JSContextRef>(js_context);
+	const auto object_ref   = static_cast<JSObjectRef>(*this);
+	const auto js_class_ref = static_cast<JSClassRef>(js_class);
+
+	for (std::size_t i = 0; i < count; ++i) {
+		JSValueRef exception { nullptr };
+		JSValueRef js_value_ref = JSObjectGetPropertyAtIndex(context_ref, object_ref, first_index + static_cast<uint32_t>(i), &exception);
+		if (exception) {
+			detail::ThrowRuntimeError("JSArray", JSValue(js_context, exception));
+		}
+
+		// JSValueIsObjectOfClass is false for non-objects, so the cast
+		// to JSObjectRef is only made for objects.
+		private_data[i] = JSValueIsObjectOfClass(context_ref, js_value_ref, js_class_ref) ? JSObjectGetPrivate(const_cast<JSObjectRef>(js_value_ref)) : nullptr;
+	}
+}
+
+JSArray JSArray::MakeArrayFromTypedArray(const JSObject& typed_array) {
+	const auto js_context      = typed_array.get_context();
+	const auto global_object   = js_context.get_global_object();
+	const auto array           = static_cast<JSObject>(global_object.GetProperty("Array"));
+	const auto array_prototype = static_cast<JSObject>(array.GetProperty("prototype"));
+	auto slice                 = static_cast<JSObject>(array_prototype.GetProperty("slice"));
+	return static_cast<JSArray>(static_cast<JSObject>(slice(typed_array)));
+}
+
+
 
 } // namespace HAL {
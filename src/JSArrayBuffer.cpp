@@ -0,0 +1,165 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSTypedArray.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include <cassert>
+
+#ifdef _WIN32
+#include <windows.h>
+#else
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
+namespace HAL {
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, std::size_t byte_length)
+		: JSObject(js_context, MakeArrayBuffer(js_context, byte_length)) {
+}
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator)
+		: JSObject(js_context, MakeArrayBufferWithBytesNoCopy(js_context, bytes, byte_length, deallocator)) {
+}
+
+JSArrayBuffer::JSArrayBuffer(const JSContext& js_context, JSObjectRef js_object_ref)
+		: JSObject(js_context, js_object_ref) {
+	if (detail::GetTypedArrayType(js_context, js_object_ref) != kJSTypedArrayTypeArrayBuffer) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "This JavaScript object is not an ArrayBuffer.");
+	}
+}
+
+JSObjectRef JSArrayBuffer::MakeArrayBuffer(const JSContext& js_context, std::size_t byte_length) {
+	// The C API can only allocate an ArrayBuffer as the backing store
+	// of a typed array, so borrow the one behind a Uint8Array.
+	const auto js_typed_array_ref = detail::MakeTypedArray(js_context, kJSTypedArrayTypeUint8Array, byte_length);
+	return detail::GetTypedArrayBuffer(js_context, js_typed_array_ref);
+}
+
+JSObjectRef JSArrayBuffer::MakeArrayBufferWithBytesNoCopy(const JSContext& js_context, void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator) {
+	// JavaScriptCore owns deallocator_context from here on and hands it
+	// back to JSTypedArrayBytesDeallocatorCallback exactly once, even
+	// if creating the ArrayBuffer fails.
+	auto deallocator_context = new std::function<void(void* bytes)>(deallocator);
+
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeArrayBufferWithBytesNoCopy(static_cast<JSContextRef>(js_context), bytes, byte_length, JSTypedArrayBytesDeallocatorCallback, deallocator_context, &exception);
+
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_object_ref.
+		assert(!js_object_ref);
+		detail::ThrowRuntimeError("JSArrayBuffer", JSValue(js_context, exception));
+	}
+
+	return js_object_ref;
+}
+
+void JSArrayBuffer::JSTypedArrayBytesDeallocatorCallback(void* bytes, void* deallocator_context) {
+	const auto deallocator_ptr = static_cast<std::function<void(void* bytes)>*>(deallocator_context);
+	HAL_LOG_DEBUG("JSArrayBuffer: release native bytes ", bytes);
+	if (*deallocator_ptr) {
+		(*deallocator_ptr)(bytes);
+	}
+	delete deallocator_ptr;
+}
+
+JSArrayBuffer JSArrayBuffer::MapFile(const JSContext& js_context, const std::string& path) {
+#ifdef _WIN32
+	const HANDLE file = CreateFileA(path.c_str(), GENERIC_READ, FILE_SHARE_READ, nullptr, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, nullptr);
+	if (file == INVALID_HANDLE_VALUE) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to open " + path + ".");
+	}
+
+	LARGE_INTEGER file_size;
+	if (!GetFileSizeEx(file, &file_size)) {
+		CloseHandle(file);
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to determine the size of " + path + ".");
+	}
+
+	const auto byte_length = static_cast<std::size_t>(file_size.QuadPart);
+	if (byte_length == 0) {
+		CloseHandle(file);
+		return JSArrayBuffer(js_context, static_cast<std::size_t>(0));
+	}
+
+	// The mapping and view keep the file open after its handle is
+	// closed.
+	const HANDLE mapping = CreateFileMappingA(file, nullptr, PAGE_WRITECOPY, 0, 0, nullptr);
+	CloseHandle(file);
+	if (mapping == nullptr) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to map " + path + ".");
+	}
+
+	void* bytes = MapViewOfFile(mapping, FILE_MAP_COPY, 0, 0, byte_length);
+	CloseHandle(mapping);
+	if (bytes == nullptr) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to map " + path + ".");
+	}
+
+	return JSArrayBuffer(js_context, bytes, byte_length, [](void* bytes) {
+		UnmapViewOfFile(bytes);
+	});
+#else
+	const int fd = open(path.c_str(), O_RDONLY);
+	if (fd < 0) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to open " + path + ".");
+	}
+
+	struct stat file_status;
+	if (fstat(fd, &file_status) != 0) {
+		close(fd);
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to determine the size of " + path + ".");
+	}
+
+	const auto byte_length = static_cast<std::size_t>(file_status.st_size);
+	if (byte_length == 0) {
+		close(fd);
+		return JSArrayBuffer(js_context, static_cast<std::size_t>(0));
+	}
+
+	// MAP_PRIVATE makes the pages copy-on-write, so scripts may write
+	// to the ArrayBuffer without modifying the read-only file. The
+	// mapping stays valid after the descriptor is closed.
+	void* bytes = mmap(nullptr, byte_length, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+	close(fd);
+	if (bytes == MAP_FAILED) {
+		detail::ThrowRuntimeError("JSArrayBuffer", "Unable to map " + path + ".");
+	}
+
+	return JSArrayBuffer(js_context, bytes, byte_length, [byte_length](void* bytes) {
+		munmap(bytes, byte_length);
+	});
+#endif
+}
+
+void* JSArrayBuffer::data() const {
+	const auto js_context = get_context();
+	JSValueRef exception { nullptr };
+	void* bytes = JSObjectGetArrayBufferBytesPtr(static_cast<JSContextRef>(js_context), static_cast<JSObjectRef>(*this), &exception);
+	if (exception) {
+		detail::ThrowRuntimeError("JSArrayBuffer", JSValue(js_context, exception));
+	}
+	return bytes;
+}
+
+std::size_t JSArrayBuffer::size() const {
+	const auto js_context = get_context();
+	JSValueRef exception { nullptr };
+	const auto byte_length = JSObjectGetArrayBufferByteLength(static_cast<JSContextRef>(js_context), static_cast<JSObjectRef>(*this), &exception);
+	if (exception) {
+		detail::ThrowRuntimeError("JSArrayBuffer", JSValue(js_context, exception));
+	}
+	return byte_length;
+}
+
+} // namespace HAL {
@@ -0,0 +1,130 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSArrayBuilder.hpp"
+
+#include "HAL/JSString.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+
+namespace HAL {
+
+  JSArrayBuilder::JSArrayBuilder(const JSContext& js_context, std::size_t capacity)
+  : js_context__(js_context) {
+    HAL_LOG_TRACE("JSArrayBuilder:: ctor ", this);
+    js_value_refs__.reserve(capacity);
+  }
+
+  void JSArrayBuilder::Reserve(std::size_t capacity) {
+    js_value_refs__.reserve(capacity);
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendUndefined() {
+    return AppendJSValueRef(JSValueMakeUndefined(static_cast<JSContextRef>(js_context__)));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendNull() {
+    return AppendJSValueRef(JSValueMakeNull(static_cast<JSContextRef>(js_context__)));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendBoolean(bool boolean) {
+    return AppendJSValueRef(JSValueMakeBoolean(static_cast<JSContextRef>(js_context__), boolean));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendNumber(double number) {
+    return AppendJSValueRef(JSValueMakeNumber(static_cast<JSContextRef>(js_context__), number));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendString(const char* string) {
+    JSStringRef js_string_ref = JSStringCreateWithUTF8CString(string);
+    AppendJSValueRef(JSValueMakeString(static_cast<JSContextRef>(js_context__), js_string_ref));
+    JSStringRelease(js_string_ref);
+    return *this;
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendString(const std::string& string) {
+    return AppendString(string.c_str());
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendString(const JSString& string) {
+    return AppendJSValueRef(JSValueMakeString(static_cast<JSContextRef>(js_context__), static_cast<JSStringRef>(string)));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::Append(const JSValue& js_value) {
+    return AppendJSValueRef(static_cast<JSValueRef>(js_value));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::Append(const JSObject& js_object) {
+    return AppendJSValueRef(static_cast<JSObjectRef>(js_object));
+  }
+
+  JSArrayBuilder& JSArrayBuilder::AppendJSValueRef(JSValueRef js_value_ref) {
+    JSValueProtect(static_cast<JSContextRef>(js_context__), js_value_ref);
+    js_value_refs__.push_back(js_value_ref);
+    return *this;
+  }
+
+  JSArray JSArrayBuilder::Build() {
+    JSValueRef exception { nullptr };
+    JSObjectRef js_object_ref = JSObjectMakeArray(static_cast<JSContextRef>(js_context__), js_value_refs__.size(), js_value_refs__.empty() ? nullptr : js_value_refs__.data(), &exception);
+
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_object_ref.
+      assert(!js_object_ref);
+      Clear();
+      detail::ThrowRuntimeError("JSArrayBuilder", JSValue(js_context__, exception));
+    }
+
+    // The JSArray protects the new array, which in turn keeps its
+    // elements alive, so the builder's protections can be dropped.
+    JSArray js_array(js_context__, js_object_ref);
+    Clear();
+    return js_array;
+  }
+
+  void JSArrayBuilder::Clear() HAL_NOEXCEPT {
+    const auto js_context_ref = static_cast<JSContextRef>(js_context__);
+    for (const auto js_value_ref : js_value_refs__) {
+      JSValueUnprotect(js_context_ref, js_value_ref);
+    }
+    js_value_refs__.clear();
+  }
+
+  JSArrayBuilder::~JSArrayBuilder() HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSArrayBuilder:: dtor ", this);
+    Clear();
+  }
+
+  JSArrayBuilder::JSArrayBuilder(JSArrayBuilder&& rhs) HAL_NOEXCEPT
+  : js_context__(rhs.js_context__)
+  , js_value_refs__(std::move(rhs.js_value_refs__)) {
+    HAL_LOG_TRACE("JSArrayBuilder:: move ctor ", this);
+    rhs.js_value_refs__.clear();
+  }
+
+  JSArrayBuilder& JSArrayBuilder::operator=(JSArrayBuilder&& rhs) HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSArrayBuilder:: move assignment ", this);
+    swap(rhs);
+    return *this;
+  }
+
+  void JSArrayBuilder::swap(JSArrayBuilder& other) HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSArrayBuilder:: swap ", this);
+    using std::swap;
+
+    // By swapping the members of two classes, the two classes are
+    // effectively swapped.
+    swap(js_context__   , other.js_context__);
+    swap(js_value_refs__, other.js_value_refs__);
+  }
+
+} // namespace HAL {
@@ -0,0 +1,109 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSCallBatcher.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSArray.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+namespace HAL {
+
+  JSCallBatcher::JSCallBatcher(const JSContext& js_context, const JSObject& callback, std::size_t max_batch_size, std::chrono::milliseconds max_delay)
+  : js_context__(js_context)
+  , function__(callback)
+  , coalesce__(true)
+  , max_batch_size__(max_batch_size)
+  , max_delay__(max_delay)
+  , pending__(js_context, max_batch_size) {
+    if (!function__.IsFunction()) {
+      detail::ThrowInvalidArgument("JSCallBatcher", "The callback of a JSCallBatcher must be a function.");
+    }
+  }
+
+  JSCallBatcher::JSCallBatcher(const JSContext& js_context, std::size_t max_batch_size, std::chrono::milliseconds max_delay)
+  : js_context__(js_context)
+  , function__(MakeDrainFunction(js_context))
+  , coalesce__(false)
+  , max_batch_size__(max_batch_size)
+  , max_delay__(max_delay)
+  , pending__(js_context, 2 * max_batch_size) {
+  }
+
+  JSCallBatcher::~JSCallBatcher() HAL_NOEXCEPT {
+  }
+
+  JSObject JSCallBatcher::MakeDrainFunction(const JSContext& js_context) {
+    // The queue holds callable and arguments pairs. Every call is
+    // made even if an earlier one throws.
+    static const std::string body =
+      "var failed = false, error;"
+      "for (var i = 0; i < queue.length; i += 2) {"
+      "  try { queue[i].apply(undefined, queue[i + 1]); } catch (e) { if (!failed) { failed = true; error = e; } }"
+      "}"
+      "if (failed) { throw error; }";
+    return js_context.CreateFunction(body, std::vector<JSString>{"queue"}, "drainCallBatch");
+  }
+
+  void JSCallBatcher::Enqueue(const JSValue& event) {
+    if (!coalesce__) {
+      detail::ThrowInvalidArgument("JSCallBatcher", "Enqueue(event) requires a JSCallBatcher created with a callback.");
+    }
+    pending__.Append(event);
+    Enqueued();
+  }
+
+  void JSCallBatcher::Enqueue(const JSObject& callable, const std::vector<JSValue>& arguments) {
+    if (coalesce__) {
+      detail::ThrowInvalidArgument("JSCallBatcher", "Enqueue(callable, arguments) requires a JSCallBatcher created without a callback.");
+    }
+    if (!callable.IsFunction()) {
+      detail::ThrowInvalidArgument("JSCallBatcher", "A queued callable must be a function.");
+    }
+    pending__.Append(callable);
+    if (arguments.empty()) {
+      pending__.AppendUndefined();
+    } else {
+      pending__.Append(js_context__.CreateArray(arguments));
+    }
+    Enqueued();
+  }
+
+  void JSCallBatcher::Enqueued() {
+    if (++pending_count__ == 1 && max_delay__.count() > 0) {
+      oldest_enqueue_time__ = Clock::now();
+    }
+    if (max_batch_size__ > 0 && pending_count__ >= max_batch_size__) {
+      Flush();
+      return;
+    }
+    FlushIfDue();
+  }
+
+  bool JSCallBatcher::FlushIfDue() {
+    if (pending_count__ == 0 || max_delay__.count() <= 0 || Clock::now() - oldest_enqueue_time__ < max_delay__) {
+      return false;
+    }
+    Flush();
+    return true;
+  }
+
+  void JSCallBatcher::Flush() {
+    if (pending_count__ == 0) {
+      return;
+    }
+
+    // Reset the queue before entering JavaScript, which may enqueue
+    // more calls.
+    JSValue batch = static_cast<JSValue>(pending__.Build());
+    pending_count__ = 0;
+    function__(batch, js_context__.get_global_object());
+  }
+
+} // namespace HAL {
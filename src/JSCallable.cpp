@@ -0,0 +1,118 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSCallable.hpp"
+
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+
+namespace HAL {
+
+  JSCallable::JSCallable(const JSObject& function)
+  : JSCallable(function, function.get_context().get_global_object()) {
+  }
+
+  JSCallable::JSCallable(const JSObject& function, const JSObject& this_object)
+  : js_context__(function.get_context())
+  , function__(function)
+  , this_object__(this_object)
+  , js_context_ref__(static_cast<JSContextRef>(js_context__))
+  , function_ref__(static_cast<JSObjectRef>(function))
+  , this_object_ref__(static_cast<JSObjectRef>(this_object)) {
+    HAL_LOG_TRACE("JSCallable:: ctor ", this);
+    if (!function__.IsFunction()) {
+      detail::ThrowRuntimeError("JSCallable", "This JavaScript object is not a function.");
+    }
+  }
+
+  JSValue JSCallable::Invoke() {
+    arguments__.clear();
+    return InvokeWithArgumentBuffer();
+  }
+
+  JSValue JSCallable::Invoke(const JSValue& argument) {
+    arguments__.clear();
+    arguments__.push_back(static_cast<JSValueRef>(argument));
+    return InvokeWithArgumentBuffer();
+  }
+
+  JSValue JSCallable::Invoke(const std::vector<JSValue>& arguments) {
+    arguments__.clear();
+    for (const auto& argument : arguments) {
+      arguments__.push_back(static_cast<JSValueRef>(argument));
+    }
+    return InvokeWithArgumentBuffer();
+  }
+
+  JSValue JSCallable::Invoke(std::size_t argument_count, const JSValueRef arguments[]) {
+    JSValueRef exception { nullptr };
+    JSValueRef js_value_ref = JSObjectCallAsFunction(js_context_ref__, function_ref__, this_object_ref__, argument_count, argument_count > 0 ? arguments : nullptr, &exception);
+
+    if (exception) {
+      // If this assert fails then we need to JSValueUnprotect
+      // js_value_ref.
+      assert(!js_value_ref);
+      detail::ThrowRuntimeError("JSCallable", JSValue(js_context__, exception));
+    }
+
+    assert(js_value_ref);
+    return JSValue(js_context__, js_value_ref);
+  }
+
+  JSValue JSCallable::InvokeWithArgumentBuffer() {
+    return Invoke(arguments__.size(), arguments__.data());
+  }
+
+  JSCallable::~JSCallable() HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSCallable:: dtor ", this);
+  }
+
+  JSCallable::JSCallable(const JSCallable& rhs) HAL_NOEXCEPT
+  : js_context__(rhs.js_context__)
+  , function__(rhs.function__)
+  , this_object__(rhs.this_object__)
+  , js_context_ref__(rhs.js_context_ref__)
+  , function_ref__(rhs.function_ref__)
+  , this_object_ref__(rhs.this_object_ref__) {
+    HAL_LOG_TRACE("JSCallable:: copy ctor ", this);
+  }
+
+  JSCallable::JSCallable(JSCallable&& rhs) HAL_NOEXCEPT
+  : js_context__(std::move(rhs.js_context__))
+  , function__(std::move(rhs.function__))
+  , this_object__(std::move(rhs.this_object__))
+  , js_context_ref__(rhs.js_context_ref__)
+  , function_ref__(rhs.function_ref__)
+  , this_object_ref__(rhs.this_object_ref__)
+  , arguments__(std::move(rhs.arguments__)) {
+    HAL_LOG_TRACE("JSCallable:: move ctor ", this);
+  }
+
+  JSCallable& JSCallable::operator=(JSCallable rhs) HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSCallable:: assignment ", this);
+    swap(rhs);
+    return *this;
+  }
+
+  void JSCallable::swap(JSCallable& other) HAL_NOEXCEPT {
+    HAL_LOG_TRACE("JSCallable:: swap ", this);
+    using std::swap;
+
+    // By swapping the members of two classes, the two classes are
+    // effectively swapped.
+    swap(js_context__      , other.js_context__);
+    swap(function__        , other.function__);
+    swap(this_object__     , other.this_object__);
+    swap(js_context_ref__  , other.js_context_ref__);
+    swap(function_ref__    , other.function_ref__);
+    swap(this_object_ref__ , other.this_object_ref__);
+    swap(arguments__       , other.arguments__);
+  }
+
+} // namespace HAL {
@@ -17,9 +17,17 @@ namespace HAL {
   
   JSClass::JSClass() HAL_NOEXCEPT
   : name__("Empty")
-  , js_class_ref__(JSClassCreate(&kJSClassDefinitionEmpty)) {
+  , js_class_ref__(JSClassRetain(EmptyJSClassRef())) {
     HAL_LOG_TRACE("JSClass:: ctor ", this);
-    HAL_LOG_TRACE("JSClass:: retain ", js_class_ref__, " (implicit) for ", this);
+    HAL_LOG_TRACE("JSClass:: retain ", js_class_ref__, " for ", this);
+  }
+  
+  JSClassRef JSClass::EmptyJSClassRef() HAL_NOEXCEPT {
+    // The empty class is immutable, so it is created once and shared
+    // by every default constructed JSClass for the lifetime of the
+    // process. This reference is intentionally never released.
+    static const JSClassRef js_class_ref = JSClassCreate(&kJSClassDefinitionEmpty);
+    return js_class_ref;
   }
   
   JSClass::JSClass(const JSClassDefinition& js_class_definition) HAL_NOEXCEPT
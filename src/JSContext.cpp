@@ -12,6 +12,7 @@
 #include "HAL/JSString.hpp"
 
 #include "HAL/JSValue.hpp"
+#include "HAL/JSExpected.hpp"
 #include "HAL/JSUndefined.hpp"
 #include "HAL/JSNull.hpp"
 #include "HAL/JSBoolean.hpp"
@@ -19,6 +20,12 @@
 
 #include "HAL/JSObject.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSDocumentProxy.hpp"
+#include "HAL/JSNativeIterator.hpp"
+#include "HAL/JSEventEmitter.hpp"
+#include "HAL/JSPromise.hpp"
+#include "HAL/JSTypedArray.hpp"
 #include "HAL/JSDate.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSFunction.hpp"
@@ -27,6 +34,7 @@
 #include "HAL/detail/JSUtil.hpp"
 
 #include <cassert>
+#include <cstring>
 
 namespace HAL {
   
@@ -97,7 +105,10 @@ namespace HAL {
   }
   
   JSObject JSContext::CreateObject() const HAL_NOEXCEPT {
-    return CreateObject(JSClass());
+    HAL_JSCONTEXT_LOCK_GUARD;
+    // A plain object doesn't need a JSClass, so skip the class
+    // retain/release altogether.
+    return JSObject(JSContext(js_global_context_ref__), JSObjectMake(js_global_context_ref__, nullptr, nullptr));
   }
   
   JSObject JSContext::CreateObject(const JSClass& js_class) const HAL_NOEXCEPT {
@@ -106,7 +117,12 @@ namespace HAL {
   }
 
   JSObject JSContext::CreateObject(const std::unordered_map<std::string, JSValue>& properties) const HAL_NOEXCEPT {
-    return CreateObject(JSClass(), properties);
+    HAL_JSCONTEXT_LOCK_GUARD;
+    auto object = CreateObject();
+    for (const auto& kv : properties) {
+      object.SetProperty(kv.first, kv.second);
+    }
+    return object;
   }
 
   JSObject JSContext::CreateObject(const JSClass& js_class, const std::unordered_map<std::string, JSValue>& properties) const HAL_NOEXCEPT {
@@ -129,6 +145,79 @@ namespace HAL {
     return JSArray(JSContext(js_global_context_ref__), arguments);
   }
   
+  JSArray JSContext::CreateArrayFromNumbers(const std::vector<double>& values) const {
+    return JSArray::MakeArrayFromTypedArray(CreateTypedArray(values));
+  }
+  
+  JSArray JSContext::CreateArrayFromNumbers(const std::vector<int32_t>& values) const {
+    return JSArray::MakeArrayFromTypedArray(CreateTypedArray(values));
+  }
+  
+  JSArray JSContext::CreateArrayFromNumbers(const std::vector<uint32_t>& values) const {
+    return JSArray::MakeArrayFromTypedArray(CreateTypedArray(values));
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBuffer(std::size_t byte_length) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer(JSContext(js_global_context_ref__), byte_length);
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBuffer(const void* bytes, std::size_t byte_length) const {
+    auto js_array_buffer = CreateArrayBuffer(byte_length);
+    if (byte_length > 0) {
+      std::memcpy(js_array_buffer.data(), bytes, byte_length);
+    }
+    return js_array_buffer;
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBufferWithBytesNoCopy(void* bytes, std::size_t byte_length, const std::function<void(void* bytes)>& deallocator) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer(JSContext(js_global_context_ref__), bytes, byte_length, deallocator);
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBufferWithBytesNoCopy(void* bytes, std::size_t byte_length, const std::shared_ptr<void>& owner) const {
+    // The lambda's copy of owner is the reference that keeps bytes
+    // alive, and it is dropped when the deallocator is destroyed.
+    return CreateArrayBufferWithBytesNoCopy(bytes, byte_length, [owner](void*) { });
+  }
+  
+  JSArrayBuffer JSContext::CreateArrayBufferFromFile(const std::string& path) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSArrayBuffer::MapFile(JSContext(js_global_context_ref__), path);
+  }
+  
+  JSObject JSContext::CreateDocumentProxy(const std::shared_ptr<JSDocumentNode>& root, bool cache_children) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSObject(JSContext(js_global_context_ref__), JSDocumentProxy::Make(js_global_context_ref__, root, cache_children));
+  }
+  
+  JSObject JSContext::CreateIterator(const std::function<bool(JSValue& value)>& source) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSNativeIterator::Make(JSContext(js_global_context_ref__), source);
+  }
+
+  JSObject JSContext::CreateEventEmitter() const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSContext(js_global_context_ref__).CreateObject(JSExport<JSEventEmitter>::Class());
+  }
+
+  std::pair<JSObject, JSPromiseResolver> JSContext::CreatePromise() const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    JSObjectRef resolve_ref { nullptr };
+    JSObjectRef reject_ref  { nullptr };
+    JSValueRef  exception   { nullptr };
+    JSObjectRef promise_ref = JSObjectMakeDeferredPromise(js_global_context_ref__, &resolve_ref, &reject_ref, &exception);
+    
+    if (exception) {
+      detail::ThrowRuntimeError("JSContext", JSValue(JSContext(js_global_context_ref__), exception));
+    }
+    
+    // The raw functions are on the stack until the resolver protects
+    // them.
+    const JSContext js_context(js_global_context_ref__);
+    return std::make_pair(JSObject(js_context, promise_ref), JSPromiseResolver(js_context, resolve_ref, reject_ref));
+  }
+  
   JSDate JSContext::CreateDate() const HAL_NOEXCEPT {
     HAL_JSCONTEXT_LOCK_GUARD;
     return JSDate(JSContext(js_global_context_ref__));
@@ -189,6 +278,11 @@ namespace HAL {
     HAL_JSCONTEXT_LOCK_GUARD;
     return JSFunction(JSContext(js_global_context_ref__), function_name, callback);
   }
+
+  JSFunction JSContext::CreateFunction(const JSString& function_name, const JSArgumentsCallback& callback) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    return JSFunction(JSContext(js_global_context_ref__), function_name, callback);
+  }
   
   JSValue JSContext::JSEvaluateScript(const JSString& script) const {
     return JSEvaluateScript(script, get_global_object(), JSString());
@@ -220,6 +314,27 @@ namespace HAL {
     return JSValue(JSContext(js_global_context_ref__), js_value_ref);
   }
   
+  JSExpected<JSValue> JSContext::TryEvaluateScript(const JSString& script) const {
+    return TryEvaluateScript(script, get_global_object(), JSString());
+  }
+  
+  JSExpected<JSValue> JSContext::TryEvaluateScript(const JSString& script, JSObject this_object) const {
+    return TryEvaluateScript(script, this_object, JSString());
+  }
+  
+  JSExpected<JSValue> JSContext::TryEvaluateScript(const JSString& script, JSObject this_object, const JSString& source_url, int starting_line_number) const {
+    HAL_JSCONTEXT_LOCK_GUARD;
+    const JSStringRef source_url_ref = (source_url.length() > 0) ? static_cast<JSStringRef>(source_url) : nullptr;
+    JSValueRef exception { nullptr };
+    const JSValueRef js_value_ref = ::JSEvaluateScript(js_global_context_ref__, static_cast<JSStringRef>(script), static_cast<JSObjectRef>(this_object), source_url_ref, starting_line_number, &exception);
+    
+    if (exception) {
+      return JSExpected<JSValue>(JSUnexpected(), JSValue(JSContext(js_global_context_ref__), exception));
+    }
+    
+    return JSValue(JSContext(js_global_context_ref__), js_value_ref);
+  }
+  
   bool JSContext::JSCheckScriptSyntax(const JSString& script) const HAL_NOEXCEPT {
     return JSCheckScriptSyntax(script, JSString());
   }
@@ -0,0 +1,275 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSDocumentProxy.hpp"
+#include "HAL/JSString.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/JSObject.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace HAL {
+
+  JSDocumentVisitor::JSDocumentVisitor(JSContextRef context_ref, bool cache_children) HAL_NOEXCEPT
+  : context_ref__(context_ref)
+  , cache_children__(cache_children) {
+  }
+
+  void JSDocumentVisitor::VisitUndefined() HAL_NOEXCEPT {
+    value_ref__ = JSValueMakeUndefined(context_ref__);
+  }
+
+  void JSDocumentVisitor::VisitNull() HAL_NOEXCEPT {
+    value_ref__ = JSValueMakeNull(context_ref__);
+  }
+
+  void JSDocumentVisitor::VisitBoolean(bool boolean) HAL_NOEXCEPT {
+    value_ref__ = JSValueMakeBoolean(context_ref__, boolean);
+  }
+
+  void JSDocumentVisitor::VisitNumber(double number) HAL_NOEXCEPT {
+    value_ref__ = JSValueMakeNumber(context_ref__, number);
+  }
+
+  void JSDocumentVisitor::VisitString(const char* string) HAL_NOEXCEPT {
+    JSStringRef js_string_ref = JSStringCreateWithUTF8CString(string);
+    value_ref__ = JSValueMakeString(context_ref__, js_string_ref);
+    JSStringRelease(js_string_ref);
+  }
+
+  void JSDocumentVisitor::VisitString(const std::string& string) HAL_NOEXCEPT {
+    VisitString(string.c_str());
+  }
+
+  void JSDocumentVisitor::VisitString(const JSString& string) HAL_NOEXCEPT {
+    value_ref__ = JSValueMakeString(context_ref__, static_cast<JSStringRef>(string));
+  }
+
+  void JSDocumentVisitor::VisitValue(const JSValue& js_value) HAL_NOEXCEPT {
+    value_ref__ = static_cast<JSValueRef>(js_value);
+  }
+
+  void JSDocumentVisitor::VisitNode(const std::shared_ptr<JSDocumentNode>& node) {
+    if (!node) {
+      VisitNull();
+      return;
+    }
+    value_ref__    = JSDocumentProxy::Make(context_ref__, node, cache_children__);
+    visited_node__ = true;
+  }
+
+  JSDocumentNode::~JSDocumentNode() HAL_NOEXCEPT {
+  }
+
+  bool JSDocumentNode::HasProperty(const std::string& property_name) const {
+    const auto property_names = GetPropertyNames();
+    return std::find(property_names.begin(), property_names.end(), property_name) != property_names.end();
+  }
+
+  std::shared_ptr<JSDocumentNode> JSDocumentProxy::GetNode(const JSObject& js_object) HAL_NOEXCEPT {
+    const auto context_ref = static_cast<JSContextRef>(js_object.get_context());
+    const auto object_ref  = static_cast<JSObjectRef>(js_object);
+    if (!JSValueIsObjectOfClass(context_ref, object_ref, Class())) {
+      return nullptr;
+    }
+    return GetPrivateData(object_ref).node;
+  }
+
+  JSClassRef JSDocumentProxy::Class() HAL_NOEXCEPT {
+    // Created once and never released, like the classes of
+    // detail::CreateFunctionClass.
+    static const JSClassRef js_class_ref = [] {
+      ::JSClassDefinition definition = kJSClassDefinitionEmpty;
+      definition.className         = "DocumentProxy";
+      definition.hasProperty       = HasPropertyCallback;
+      definition.getProperty       = GetPropertyCallback;
+      definition.setProperty       = SetPropertyCallback;
+      definition.getPropertyNames  = GetPropertyNamesCallback;
+      definition.finalize          = detail::DeletePrivateData<PrivateData>;
+      return ::JSClassCreate(&definition);
+    }();
+    return js_class_ref;
+  }
+
+  JSDocumentProxy::PrivateData& JSDocumentProxy::GetPrivateData(JSObjectRef object_ref) HAL_NOEXCEPT {
+    return *static_cast<PrivateData*>(JSObjectGetPrivate(object_ref));
+  }
+
+  JSObjectRef JSDocumentProxy::Make(JSContextRef context_ref, const std::shared_ptr<JSDocumentNode>& node, bool cache_children) {
+    if (!node) {
+      detail::ThrowInvalidArgument("JSDocumentProxy", "The node of a document proxy must not be null.");
+    }
+
+    // The finalizer of the class deletes the private data.
+    auto private_data = new PrivateData();
+    private_data->node           = node;
+    private_data->cache_children = cache_children;
+    private_data->is_array       = node->IsArray();
+    JSObjectRef object_ref = JSObjectMake(context_ref, Class(), private_data);
+
+    if (private_data->is_array) {
+      static const JSStringRef array_name_ref     = JSStringCreateWithUTF8CString("Array");
+      static const JSStringRef prototype_name_ref = JSStringCreateWithUTF8CString("prototype");
+      JSValueRef exception { nullptr };
+      JSValueRef array_ref = JSObjectGetProperty(context_ref, JSContextGetGlobalObject(context_ref), array_name_ref, &exception);
+      if (!exception && JSValueIsObject(context_ref, array_ref)) {
+        JSValueRef prototype_ref = JSObjectGetProperty(context_ref, JSValueToObject(context_ref, array_ref, nullptr), prototype_name_ref, &exception);
+        if (!exception) {
+          JSObjectSetPrototype(context_ref, object_ref, prototype_ref);
+        }
+      }
+    }
+
+    return object_ref;
+  }
+
+  JSValueRef JSDocumentProxy::MakeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT {
+    HAL_LOG_ERROR("JSDocumentProxy: ", message);
+    return detail::MakeError(context_ref, message);
+  }
+
+  void JSDocumentProxy::CacheChild(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, const std::string& property_name, JSValueRef child_ref) {
+    // Store the child proxy on the JavaScript object itself so that
+    // the parent keeps it alive. DontEnum keeps it from being listed
+    // twice, since GetPropertyNamesCallback already lists it.
+    //
+    // The name is cached first so that HasPropertyCallback no longer
+    // claims it. JavaScriptCore only applies the attributes to a
+    // property that the object doesn't have yet.
+    auto& private_data = GetPrivateData(object_ref);
+    private_data.cached_names.insert(property_name);
+    private_data.caching = true;
+    JSObjectSetProperty(context_ref, object_ref, property_name_ref, child_ref, kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontEnum | kJSPropertyAttributeDontDelete, nullptr);
+    private_data.caching = false;
+  }
+
+  bool JSDocumentProxy::HasPropertyCallback(JSContextRef, JSObjectRef object_ref, JSStringRef property_name_ref) try {
+    const auto& private_data = GetPrivateData(object_ref);
+
+    // A cached child is found in the object's own storage, where
+    // CacheChild put it. Claiming it here would make JavaScriptCore
+    // expect GetPropertyCallback to return it.
+    const auto is_cached = [&private_data](const std::string& property_name) {
+      return private_data.cached_names.find(property_name) != private_data.cached_names.end();
+    };
+
+    if (private_data.is_array) {
+      uint32_t index { 0 };
+      if (detail::to_array_index(property_name_ref, index)) {
+        return index < private_data.node->GetLength() && !is_cached(std::to_string(index));
+      }
+      return JSStringIsEqualToUTF8CString(property_name_ref, "length");
+    }
+
+    const auto property_name = static_cast<std::string>(JSString(property_name_ref));
+    return !is_cached(property_name) && private_data.node->HasProperty(property_name);
+  } catch (const std::exception& e) {
+    HAL_LOG_ERROR("JSDocumentProxy: HasProperty: ", e.what());
+    return false;
+  } catch (...) {
+    HAL_LOG_ERROR("JSDocumentProxy: HasProperty: unknown exception");
+    return false;
+  }
+
+  JSValueRef JSDocumentProxy::GetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef* exception) try {
+    auto& private_data = GetPrivateData(object_ref);
+    JSDocumentVisitor visitor(context_ref, private_data.cache_children);
+    bool found = false;
+
+    if (private_data.is_array) {
+      uint32_t index { 0 };
+      if (!detail::to_array_index(property_name_ref, index)) {
+        if (JSStringIsEqualToUTF8CString(property_name_ref, "length")) {
+          return JSValueMakeNumber(context_ref, static_cast<double>(private_data.node->GetLength()));
+        }
+        // Forward everything else to the prototype chain.
+        return nullptr;
+      }
+      if (index >= private_data.node->GetLength()) {
+        return nullptr;
+      }
+      const auto property_name = std::to_string(index);
+      if (private_data.cached_names.find(property_name) != private_data.cached_names.end()) {
+        return nullptr;
+      }
+      found = private_data.node->VisitElement(index, visitor);
+      if (found && visitor.visited_node__ && private_data.cache_children) {
+        CacheChild(context_ref, object_ref, property_name_ref, property_name, visitor.value_ref__);
+      }
+    } else {
+      const auto property_name = static_cast<std::string>(JSString(property_name_ref));
+      // A cached child is read from the object's own storage.
+      if (private_data.cached_names.find(property_name) != private_data.cached_names.end()) {
+        return nullptr;
+      }
+      found = private_data.node->VisitProperty(property_name, visitor);
+      if (found && visitor.visited_node__ && private_data.cache_children) {
+        CacheChild(context_ref, object_ref, property_name_ref, property_name, visitor.value_ref__);
+      }
+    }
+
+    if (!found) {
+      return nullptr;
+    }
+
+    // A node that found the property but did not visit a value reads
+    // as undefined.
+    return visitor.value_ref__ ? visitor.value_ref__ : JSValueMakeUndefined(context_ref);
+  } catch (const std::exception& e) {
+    *exception = MakeError(context_ref, e.what());
+    return nullptr;
+  } catch (...) {
+    *exception = MakeError(context_ref, "unknown exception");
+    return nullptr;
+  }
+
+  bool JSDocumentProxy::SetPropertyCallback(JSContextRef context_ref, JSObjectRef object_ref, JSStringRef property_name_ref, JSValueRef, JSValueRef* exception) try {
+    const auto& private_data = GetPrivateData(object_ref);
+
+    // Let CacheChild store the child proxy.
+    if (private_data.caching) {
+      return false;
+    }
+
+    // Document properties, including cached children, are read-only,
+    // so assignments to them are ignored. Other properties are stored
+    // on the object as usual.
+    const auto property_name = static_cast<std::string>(JSString(property_name_ref));
+    return private_data.cached_names.find(property_name) != private_data.cached_names.end() || HasPropertyCallback(context_ref, object_ref, property_name_ref);
+  } catch (const std::exception& e) {
+    *exception = MakeError(context_ref, e.what());
+    return false;
+  }
+
+  void JSDocumentProxy::GetPropertyNamesCallback(JSContextRef, JSObjectRef object_ref, JSPropertyNameAccumulatorRef property_names) try {
+    const auto& private_data = GetPrivateData(object_ref);
+    if (private_data.is_array) {
+      const auto length = private_data.node->GetLength();
+      for (std::size_t index = 0; index < length; ++index) {
+        JSStringRef property_name_ref = JSStringCreateWithUTF8CString(std::to_string(index).c_str());
+        JSPropertyNameAccumulatorAddName(property_names, property_name_ref);
+        JSStringRelease(property_name_ref);
+      }
+      return;
+    }
+
+    for (const auto& property_name : private_data.node->GetPropertyNames()) {
+      JSStringRef property_name_ref = JSStringCreateWithUTF8CString(property_name.c_str());
+      JSPropertyNameAccumulatorAddName(property_names, property_name_ref);
+      JSStringRelease(property_name_ref);
+    }
+  } catch (const std::exception& e) {
+    HAL_LOG_ERROR("JSDocumentProxy: GetPropertyNames: ", e.what());
+  } catch (...) {
+    HAL_LOG_ERROR("JSDocumentProxy: GetPropertyNames: unknown exception");
+  }
+
+} // namespace HAL {
@@ -16,19 +16,48 @@
 #include <algorithm>
 #include <stdexcept>
 #include <cassert>
+#include <sstream>
 
 namespace HAL {
 
-std::deque<std::string> JSError::NativeStack__; 
+namespace {
+
+	struct NativeStackFrameNames {
+		const char* class_name;
+		const char* function_name;
+
+		// The depth of the frame, so that a slot overwritten by a deeper
+		// frame isn't formatted once that frame has returned.
+		std::size_t depth;
+	};
+
+	// Each thread has its own native stack, so pushing a frame needs
+	// neither a lock nor an allocation. depth keeps counting past the
+	// capacity, and only the innermost frames are kept.
+	struct NativeStack {
+		NativeStackFrameNames frames[JSError::NativeStackCapacity];
+		std::size_t           depth;
+	};
+
+	// Zero-initialized, as HAL_THREAD_LOCAL requires.
+	HAL_THREAD_LOCAL NativeStack native_stack;
+
+} // namespace {
+
+const std::size_t JSError::NativeStackCapacity;
 
 JSError::JSError(const JSContext& js_context, const std::vector<JSValue>& arguments)
 		: JSObject(js_context, MakeError(js_context, arguments)) {
-	SetProperty("nativeStack", js_context.CreateString(JSError::GetNativeStack()));
+	if (HasNativeStack()) {
+		SetProperty("nativeStack", js_context.CreateString(JSError::GetNativeStack()));
+	}
 }
 
 JSError::JSError(const JSContext& js_context, JSObjectRef js_object_ref)
 		: JSObject(js_context, js_object_ref) {
-	SetProperty("nativeStack", js_context.CreateString(JSError::GetNativeStack()));
+	if (HasNativeStack()) {
+		SetProperty("nativeStack", js_context.CreateString(JSError::GetNativeStack()));
+	}
 }
 
 std::string JSError::message() const {
@@ -75,14 +104,35 @@ std::string JSError::nativeStack() const {
 
 std::string JSError::GetNativeStack() {
 	std::ostringstream stacktrace;
-	for (auto iter = JSError::NativeStack__.rbegin(); iter != JSError::NativeStack__.rend(); ++iter) {
-		stacktrace << (std::distance(JSError::NativeStack__.rbegin(), iter) + 1) << "  " << *iter << "\n";
+	std::size_t number = 0;
+	for (std::size_t depth = native_stack.depth; depth > 0 && native_stack.depth - depth < NativeStackCapacity; --depth) {
+		const auto& frame = native_stack.frames[(depth - 1) % NativeStackCapacity];
+		if (frame.depth == depth - 1) {
+			stacktrace << ++number << "  JSExportClass<" << frame.class_name << ">::" << frame.function_name << "\n";
+		}
 	}
 	return stacktrace.str();
 }
 
-void JSError::ClearNativeStack() {
-	JSError::NativeStack__.clear();
+bool JSError::HasNativeStack() HAL_NOEXCEPT {
+	return native_stack.depth > 0;
+}
+
+void JSError::ClearNativeStack() HAL_NOEXCEPT {
+	native_stack.depth = 0;
+}
+
+void JSError::PushNativeStack(const char* class_name, const char* function_name) HAL_NOEXCEPT {
+	auto& frame = native_stack.frames[native_stack.depth % NativeStackCapacity];
+	frame.class_name    = class_name;
+	frame.function_name = function_name;
+	frame.depth         = native_stack.depth++;
+}
+
+void JSError::PopNativeStack() HAL_NOEXCEPT {
+	if (native_stack.depth > 0) {
+		--native_stack.depth;
+	}
 }
 
 JSObjectRef JSError::MakeError(const JSContext& js_context, const std::vector<JSValue>& arguments) {
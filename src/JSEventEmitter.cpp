@@ -0,0 +1,222 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSEventEmitter.hpp"
+#include "HAL/JSBoolean.hpp"
+#include "HAL/JSNumber.hpp"
+#include "HAL/JSError.hpp"
+#include "HAL/JSFunction.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <algorithm>
+#include <iterator>
+
+namespace HAL {
+
+  JSEventEmitter::JSEventEmitter(const JSContext& js_context) HAL_NOEXCEPT
+  : JSExportObject(js_context) {
+    HAL_LOG_DEBUG("JSEventEmitter:: ctor ", this);
+  }
+
+  JSEventEmitter::~JSEventEmitter() HAL_NOEXCEPT {
+    HAL_LOG_DEBUG("JSEventEmitter:: dtor ", this);
+  }
+
+  void JSEventEmitter::JSExportInitialize() {
+    JSExport<JSEventEmitter>::SetClassVersion(1);
+    JSExport<JSEventEmitter>::AddFunctionProperty("on"                , &JSEventEmitter::js_on);
+    JSExport<JSEventEmitter>::AddFunctionProperty("once"              , &JSEventEmitter::js_once);
+    JSExport<JSEventEmitter>::AddFunctionProperty("off"               , &JSEventEmitter::js_off);
+    JSExport<JSEventEmitter>::AddFunctionProperty("removeAllListeners", &JSEventEmitter::js_removeAllListeners);
+    JSExport<JSEventEmitter>::AddFunctionProperty("listenerCount"     , &JSEventEmitter::js_listenerCount);
+    JSExport<JSEventEmitter>::AddFunctionProperty("emit"              , &JSEventEmitter::js_emit);
+  }
+
+  void JSEventEmitter::On(const JSString& event_name, const JSObject& listener) {
+    AddListener(event_name, listener, false);
+  }
+
+  void JSEventEmitter::Once(const JSString& event_name, const JSObject& listener) {
+    AddListener(event_name, listener, true);
+  }
+
+  void JSEventEmitter::AddListener(const JSString& event_name, const JSObject& listener, bool once) {
+    if (!listener.IsFunction()) {
+      detail::ThrowInvalidArgument("JSEventEmitter", "The listener of event '" + static_cast<std::string>(event_name) + "' must be a function.");
+    }
+    listeners__[event_name].emplace_back(listener, once);
+  }
+
+  bool JSEventEmitter::Off(const JSString& event_name, const JSObject& listener) {
+    const auto position = listeners__.find(event_name);
+    if (position == listeners__.end()) {
+      return false;
+    }
+
+    auto& listeners = position->second;
+    const auto listener_ref = static_cast<JSObjectRef>(listener);
+    const auto found = std::find_if(listeners.rbegin(), listeners.rend(), [listener_ref](const Listener& candidate) {
+      return !candidate.removed && static_cast<JSObjectRef>(candidate.function) == listener_ref;
+    });
+    if (found == listeners.rend()) {
+      return false;
+    }
+
+    found->removed = true;
+    has_removed_listeners__ = true;
+    EraseRemovedListeners();
+    return true;
+  }
+
+  void JSEventEmitter::RemoveAllListeners(const JSString& event_name) {
+    const auto position = listeners__.find(event_name);
+    if (position == listeners__.end()) {
+      return;
+    }
+    for (auto& listener : position->second) {
+      listener.removed = true;
+    }
+    has_removed_listeners__ = true;
+    EraseRemovedListeners();
+  }
+
+  std::size_t JSEventEmitter::GetListenerCount(const JSString& event_name) const HAL_NOEXCEPT {
+    const auto position = listeners__.find(event_name);
+    if (position == listeners__.end()) {
+      return 0;
+    }
+    return static_cast<std::size_t>(std::count_if(position->second.begin(), position->second.end(), [](const Listener& listener) {
+      return !listener.removed;
+    }));
+  }
+
+  bool JSEventEmitter::Emit(const JSString& event_name, const std::vector<JSValue>& arguments) {
+    std::vector<JSValue> errors;
+    const bool had_listeners = Emit(event_name, arguments, errors);
+    ThrowErrors(event_name, errors);
+    return had_listeners;
+  }
+
+  bool JSEventEmitter::Emit(const JSString& event_name, const std::vector<JSValue>& arguments, std::vector<JSValue>& errors) {
+    const auto argument_refs = detail::to_vector(arguments);
+    return Emit(event_name, static_cast<JSObjectRef>(get_object()), argument_refs.size(), argument_refs.data(), errors);
+  }
+
+  bool JSEventEmitter::Emit(const JSString& event_name, JSObjectRef this_object_ref, std::size_t argument_count, const JSValueRef arguments[], std::vector<JSValue>& errors) {
+    const auto position = listeners__.find(event_name);
+    if (position == listeners__.end() || position->second.empty()) {
+      return false;
+    }
+
+    // Listeners may add or remove listeners while they are called, so
+    // the vector is indexed rather than iterated, and removed
+    // listeners are only marked until the outermost emit is done.
+    // Elements of an unordered_map don't move on rehash, so the vector
+    // itself stays put.
+    auto& listeners = position->second;
+    const auto listener_count = listeners.size();
+    const auto js_context  = get_context();
+    const auto context_ref = static_cast<JSContextRef>(js_context);
+    bool had_listeners = false;
+
+    ++emit_depth__;
+    for (std::size_t i = 0; i < listener_count; ++i) {
+      if (listeners[i].removed) {
+        continue;
+      }
+      if (listeners[i].once) {
+        listeners[i].removed    = true;
+        has_removed_listeners__ = true;
+      }
+      had_listeners = true;
+
+      // The listener is kept alive by its entry, which is not erased
+      // during the emit.
+      JSValueRef exception { nullptr };
+      JSObjectCallAsFunction(context_ref, static_cast<JSObjectRef>(listeners[i].function), this_object_ref, argument_count, arguments, &exception);
+      if (exception) {
+        errors.push_back(JSValue(js_context, exception));
+      }
+    }
+    --emit_depth__;
+
+    EraseRemovedListeners();
+    return had_listeners;
+  }
+
+  void JSEventEmitter::ThrowErrors(const JSString& event_name, const std::vector<JSValue>& errors) const {
+    if (errors.empty()) {
+      return;
+    }
+
+    std::string message = std::to_string(errors.size()) + (errors.size() == 1 ? " listener" : " listeners") + " of '" + static_cast<std::string>(event_name) + "' threw:";
+    for (const auto& error : errors) {
+      message += " " + detail::ToStdString(static_cast<JSContextRef>(get_context()), static_cast<JSValueRef>(error)) + ";";
+    }
+    message.pop_back();
+
+    const auto js_context = get_context();
+    auto js_error = js_context.CreateError(std::vector<JSValue> { js_context.CreateString(message) });
+    js_error.SetProperty("name"  , js_context.CreateString("AggregateError"));
+    js_error.SetProperty("errors", js_context.CreateArray(errors));
+    detail::ThrowRuntimeError("JSEventEmitter", static_cast<JSValue>(js_error));
+  }
+
+  void JSEventEmitter::EraseRemovedListeners() {
+    if (emit_depth__ > 0 || !has_removed_listeners__) {
+      return;
+    }
+    for (auto position = listeners__.begin(); position != listeners__.end();) {
+      auto& listeners = position->second;
+      listeners.erase(std::remove_if(listeners.begin(), listeners.end(), [](const Listener& listener) {
+        return listener.removed;
+      }), listeners.end());
+      position = listeners.empty() ? listeners__.erase(position) : std::next(position);
+    }
+    has_removed_listeners__ = false;
+  }
+
+  JSValue JSEventEmitter::js_on(const JSArguments& arguments, JSObject& this_object) {
+    On(static_cast<JSString>(arguments[0]), static_cast<JSObject>(arguments[1]));
+    return this_object;
+  }
+
+  JSValue JSEventEmitter::js_once(const JSArguments& arguments, JSObject& this_object) {
+    Once(static_cast<JSString>(arguments[0]), static_cast<JSObject>(arguments[1]));
+    return this_object;
+  }
+
+  JSValue JSEventEmitter::js_off(const JSArguments& arguments, JSObject& this_object) {
+    if (arguments.IsObject(1)) {
+      Off(static_cast<JSString>(arguments[0]), static_cast<JSObject>(arguments[1]));
+    }
+    return this_object;
+  }
+
+  JSValue JSEventEmitter::js_removeAllListeners(const JSArguments& arguments, JSObject& this_object) {
+    RemoveAllListeners(static_cast<JSString>(arguments[0]));
+    return this_object;
+  }
+
+  JSValue JSEventEmitter::js_listenerCount(const JSArguments& arguments, JSObject&) {
+    return get_context().CreateNumber(static_cast<double>(GetListenerCount(static_cast<JSString>(arguments[0]))));
+  }
+
+  JSValue JSEventEmitter::js_emit(const JSArguments& arguments, JSObject& this_object) {
+    // The listeners are given the script's own argument values,
+    // without converting them to JSValues and back.
+    const auto event_name = static_cast<JSString>(arguments[0]);
+    std::vector<JSValue> errors;
+    const bool had_listeners = arguments.size() > 1
+        ? Emit(event_name, static_cast<JSObjectRef>(this_object), arguments.size() - 1, arguments.data() + 1, errors)
+        : Emit(event_name, static_cast<JSObjectRef>(this_object), 0, nullptr, errors);
+    ThrowErrors(event_name, errors);
+    return get_context().CreateBoolean(had_listeners);
+  }
+
+} // namespace HAL {
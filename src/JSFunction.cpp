@@ -26,40 +26,12 @@ JSFunction::JSFunction(const JSContext& js_context, const JSString& function_nam
         : JSObject(js_context, MakeFunction(js_context, function_name, callback)) {
 }
 
-JSFunction::JSFunction(const JSFunction& rhs) : JSObject(rhs) {
-    RetainCallbackAfterCopy();
-}
-
-JSFunction::JSFunction(JSFunction&& rhs) : JSObject(std::move(rhs)) {
-    RetainCallbackAfterCopy();
-}
-
-JSFunction& JSFunction::operator=(const JSFunction& rhs) {
-    JSObject::operator=(rhs);
-    RetainCallbackAfterCopy();
-    return *this;
-}
-
-JSFunction& JSFunction::operator=(JSFunction&& rhs) {
-    JSObject::operator=(std::move(rhs));
-    RetainCallbackAfterCopy();
-    return *this;
+JSFunction::JSFunction(const JSContext& js_context, const JSString& function_name, const JSArgumentsCallback& callback)
+        : JSObject(js_context, MakeFunction(js_context, function_name, callback)) {
 }
 
-/**
- * To keep the callback valid after the destruction of rhs,
- * we must obtain a new JSObjectRef and register the callback with it.
- * The rhs will unregister the callback with the original js_object_ref__ in destructor.
- */
-void JSFunction::RetainCallbackAfterCopy() {
-    const auto &callback = FindJSFunctionCallback(js_object_ref__);
-    if (callback) {
-        JSValue name(js_context__, JSObjectGetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(JSString("name")), nullptr));
-        std::string name_string = static_cast<std::string>(name);
-        UnRegisterJSContext(js_object_ref__);
-        js_object_ref__ = MakeFunction(js_context__, static_cast<JSString>(name), callback);
-        JSFunction::RegisterJSFunctionCallback(js_object_ref__, callback);
-    }
+JSFunction::JSFunction(const JSContext& js_context, JSObjectRef js_object_ref)
+        : JSObject(js_context, js_object_ref) {
 }
 
 JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& body, const std::vector<JSString>& parameter_names, const JSString& func_name, const JSString& source_url, int starting_line_number) {
@@ -89,47 +61,53 @@ JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString
     return js_object_ref;
 }
 
-std::unordered_map<std::intptr_t, JSFunctionCallback> JSFunction::js_object_ref_to_js_function__;
+JSClassRef JSFunction::JSFunctionCallbackClass() HAL_NOEXCEPT {
+    static const JSClassRef js_class_ref = detail::CreateFunctionClass(JSObjectCallAsFunctionCallback, detail::DeletePrivateData<JSFunctionCallback>);
+    return js_class_ref;
+}
 
-void JSFunction::RegisterJSFunctionCallback(JSObjectRef js_object_ref, JSFunctionCallback callback) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key   = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto value = callback;
-    const auto position = js_object_ref_to_js_function__.find(key);
-    const bool found    = position != js_object_ref_to_js_function__.end();
-    
-    if (found) {
-      HAL_LOG_DEBUG("JSFunction::RegisterJSFunctionCallback: JSObjectRef ", js_object_ref, " already registered");
-    } else {
-      const auto insert_result = js_object_ref_to_js_function__.emplace(key, value);
-      const bool inserted      = insert_result.second;
-      
-      assert(inserted);
-    }
+JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback) {
+    // The function object owns a copy of the callback, which its
+    // finalizer deletes.
+    return MakeFunction(js_context, function_name, JSFunctionCallbackClass(), new JSFunctionCallback(callback));
 }
 
-void JSFunction::UnRegisterJSFunctionCallback(JSObjectRef js_object_ref) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key = reinterpret_cast<std::intptr_t>(js_object_ref);
-    js_object_ref_to_js_function__.erase(key);
+JSClassRef JSFunction::JSArgumentsCallbackClass() HAL_NOEXCEPT {
+    static const JSClassRef js_class_ref = detail::CreateFunctionClass(JSArgumentsCallAsFunctionCallback, detail::DeletePrivateData<JSArgumentsCallback>);
+    return js_class_ref;
 }
 
-JSFunctionCallback JSFunction::FindJSFunctionCallback(JSObjectRef js_object_ref) {
-    HAL_JSOBJECT_LOCK_GUARD_STATIC;
-    const auto key      = reinterpret_cast<std::intptr_t>(js_object_ref);
-    const auto position = js_object_ref_to_js_function__.find(key);
-    const bool found    = position != js_object_ref_to_js_function__.end();
-    
-    if (found) {
-      return position->second;
-    } else {
-        return nullptr;
+JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, const JSArgumentsCallback& callback) {
+    if (!callback) {
+        detail::ThrowInvalidArgument("JSFunction", "callback is missing");
     }
+    // The finalizer of the function deletes the copy of the callback.
+    return MakeFunction(js_context, function_name, JSArgumentsCallbackClass(), new JSArgumentsCallback(callback));
+}
+
+JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, JSClassRef js_class_ref, void* private_data) {
+    const auto context_ref = static_cast<JSContextRef>(js_context);
+    JSObjectRef js_object_ref = JSObjectMake(context_ref, js_class_ref, private_data);
+
+    // Give the function the same name and prototype as one created by
+    // JSObjectMakeFunctionWithCallback, so that call, apply and bind
+    // work on it. The name is set first because Function.prototype
+    // has a read-only name of its own.
+    static const JSStringRef function_name_ref  = JSStringCreateWithUTF8CString("Function");
+    static const JSStringRef prototype_name_ref = JSStringCreateWithUTF8CString("prototype");
+    static const JSStringRef name_name_ref      = JSStringCreateWithUTF8CString("name");
+    JSObjectSetProperty(context_ref, js_object_ref, name_name_ref, JSValueMakeString(context_ref, static_cast<JSStringRef>(function_name)), kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontEnum | kJSPropertyAttributeDontDelete, nullptr);
+    JSValueRef function_constructor_ref = JSObjectGetProperty(context_ref, JSContextGetGlobalObject(context_ref), function_name_ref, nullptr);
+    if (JSValueIsObject(context_ref, function_constructor_ref)) {
+        JSObjectSetPrototype(context_ref, js_object_ref, JSObjectGetProperty(context_ref, JSValueToObject(context_ref, function_constructor_ref, nullptr), prototype_name_ref, nullptr));
+    }
+
+    return js_object_ref;
 }
 
 JSValueRef JSFunction::JSObjectCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) {
-    const auto callback = FindJSFunctionCallback(function_ref);
-    if (callback == nullptr) {
+    const auto callback_ptr = static_cast<JSFunctionCallback*>(JSObjectGetPrivate(function_ref));
+    if (callback_ptr == nullptr || !*callback_ptr) {
         return JSValueMakeUndefined(context_ref);
     }
     const auto ctx = JSContext(context_ref);
@@ -139,17 +117,65 @@ JSValueRef JSFunction::JSObjectCallAsFunctionCallback(JSContextRef context_ref,
         arguments.push_back(JSValue(ctx, arguments_array[i]));
     }
     auto this_object = JSObject(ctx, this_object_ref);
-    return static_cast<JSValueRef>(callback(arguments, this_object));
+    return static_cast<JSValueRef>((*callback_ptr)(arguments, this_object));
 }
 
-JSObjectRef JSFunction::MakeFunction(const JSContext& js_context, const JSString& function_name, const JSFunctionCallback& callback) {
-    JSObjectRef js_object_ref = JSObjectMakeFunctionWithCallback(static_cast<JSContextRef>(js_context), static_cast<JSStringRef>(function_name), JSFunction::JSObjectCallAsFunctionCallback);
-    JSFunction::RegisterJSFunctionCallback(js_object_ref, callback);
-    return js_object_ref;
+JSValueRef JSFunction::JSArgumentsCallAsFunctionCallback(JSContextRef context_ref, JSObjectRef function_ref, JSObjectRef this_object_ref, size_t argument_count, const JSValueRef arguments_array[], JSValueRef* exception) {
+    const auto callback_ptr = static_cast<JSArgumentsCallback*>(JSObjectGetPrivate(function_ref));
+    try {
+        // Neither the arguments nor their count are copied.
+        const JSArguments arguments(context_ref, argument_count, arguments_array);
+        auto this_object = JSObject(JSContext(context_ref), this_object_ref);
+        return static_cast<JSValueRef>((*callback_ptr)(arguments, this_object));
+    } catch (const detail::js_runtime_error& e) {
+        // Rethrow a script's Error untouched.
+        *exception = static_cast<JSValueRef>(e.js_error());
+    } catch (const std::exception& e) {
+        *exception = detail::MakeError(context_ref, e.what());
+    } catch (...) {
+        *exception = detail::MakeError(context_ref, "unknown exception");
+    }
+    return nullptr;
 }
 
-JSFunction::~JSFunction() HAL_NOEXCEPT {
-    JSFunction::UnRegisterJSFunctionCallback(js_object_ref__);
-}
     
+namespace detail {
+
+JSValueRef MakeTypeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT {
+    static const JSStringRef type_error_name_ref = JSStringCreateWithUTF8CString("TypeError");
+    JSStringRef message_ref = JSStringCreateWithUTF8CString(message.c_str());
+    const JSValueRef arguments[] = { JSValueMakeString(context_ref, message_ref) };
+    JSStringRelease(message_ref);
+
+    JSValueRef type_error_ref = JSObjectGetProperty(context_ref, JSContextGetGlobalObject(context_ref), type_error_name_ref, nullptr);
+    if (JSValueIsObject(context_ref, type_error_ref)) {
+        JSObjectRef js_error_ref = JSObjectCallAsConstructor(context_ref, JSValueToObject(context_ref, type_error_ref, nullptr), 1, arguments, nullptr);
+        if (js_error_ref) {
+            return js_error_ref;
+        }
+    }
+    return JSObjectMakeError(context_ref, 1, arguments, nullptr);
+}
+
+JSValueRef MakeError(JSContextRef context_ref, const std::string& message) HAL_NOEXCEPT {
+    JSStringRef message_ref = JSStringCreateWithUTF8CString(message.c_str());
+    const JSValueRef arguments[] = { JSValueMakeString(context_ref, message_ref) };
+    JSStringRelease(message_ref);
+    return JSObjectMakeError(context_ref, 1, arguments, nullptr);
+}
+
+std::string ToStdString(JSContextRef context_ref, JSValueRef js_value_ref, JSValueRef* exception) {
+    JSStringRef js_string_ref = JSValueToStringCopy(context_ref, js_value_ref, exception);
+    if (!js_string_ref) {
+        return std::string();
+    }
+    std::string string(JSStringGetMaximumUTF8CStringSize(js_string_ref), '\0');
+    const auto size = JSStringGetUTF8CString(js_string_ref, &string[0], string.size());
+    JSStringRelease(js_string_ref);
+    string.resize(size > 0 ? size - 1 : 0);
+    return string;
+}
+
+} // namespace detail {
+
 } // namespace HAL {
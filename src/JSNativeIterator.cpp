@@ -0,0 +1,74 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSNativeIterator.hpp"
+#include "HAL/JSUndefined.hpp"
+
+namespace HAL {
+
+  JSNativeIterator::JSNativeIterator(const JSContext& js_context) HAL_NOEXCEPT
+  : JSExportObject(js_context)
+  , result_template__(js_context, std::vector<JSString> { "value", "done" }) {
+    HAL_LOG_DEBUG("JSNativeIterator:: ctor ", this);
+  }
+
+  JSNativeIterator::~JSNativeIterator() HAL_NOEXCEPT {
+    HAL_LOG_DEBUG("JSNativeIterator:: dtor ", this);
+  }
+
+  void JSNativeIterator::JSExportInitialize() {
+    JSExport<JSNativeIterator>::SetClassVersion(1);
+    JSExport<JSNativeIterator>::AddFunctionProperty("next"  , &JSNativeIterator::js_next  , false);
+    JSExport<JSNativeIterator>::AddFunctionProperty("return", &JSNativeIterator::js_return, false);
+  }
+
+  JSObject JSNativeIterator::Make(const JSContext& js_context, const Source& source) {
+    auto js_object = js_context.CreateObject(JSExport<JSNativeIterator>::Class());
+    js_object.GetPrivateReference<JSNativeIterator>().source__ = source;
+
+    // The prototype that JavaScriptCore creates for this class in each
+    // context inherits from Object.prototype. Making it inherit from
+    // %IteratorPrototype% instead gives every iterator a
+    // [Symbol.iterator]() that returns itself, which the C API can't
+    // define directly. The re-parented chain is itself the
+    // per-context state: only Object.prototype has a null prototype,
+    // so checking it takes two raw lookups and no allocation.
+    const auto context_ref         = static_cast<JSContextRef>(js_context);
+    const auto class_prototype_ref = JSValueToObject(context_ref, JSObjectGetPrototype(context_ref, static_cast<JSObjectRef>(js_object)), nullptr);
+    const auto parent_ref          = JSValueToObject(context_ref, JSObjectGetPrototype(context_ref, class_prototype_ref), nullptr);
+    if (JSValueIsNull(context_ref, JSObjectGetPrototype(context_ref, parent_ref))) {
+      JSObjectSetPrototype(context_ref, class_prototype_ref, static_cast<JSValueRef>(js_context.JSEvaluateScript("Object.getPrototypeOf(Object.getPrototypeOf([][Symbol.iterator]()));")));
+    }
+
+    return js_object;
+  }
+
+  JSValue JSNativeIterator::js_next(const JSArguments&, JSObject&) {
+    const auto js_context = get_context();
+    JSValue value = js_context.CreateUndefined();
+    if (source__ && source__(value)) {
+      return MakeResult(value, false);
+    }
+
+    // Release whatever the source holds on to, such as a database
+    // cursor, as soon as it is exhausted.
+    source__ = nullptr;
+    return MakeResult(js_context.CreateUndefined(), true);
+  }
+
+  JSValue JSNativeIterator::js_return(const JSArguments& arguments, JSObject&) {
+    // for...of calls return when the loop is left early.
+    source__ = nullptr;
+    return MakeResult(arguments[0], true);
+  }
+
+  JSObject JSNativeIterator::MakeResult(const JSValue& value, bool done) const {
+    return result_template__.CreateObject(value, done);
+  }
+
+} // namespace HAL {
@@ -8,6 +8,8 @@
 
 #include "HAL/JSObject.hpp"
 #include "HAL/JSValue.hpp"
+#include "HAL/JSExpected.hpp"
+#include "HAL/JSFunction.hpp"
 
 #include "HAL/JSClass.hpp"
 
@@ -17,6 +19,8 @@
 #include "HAL/JSNumber.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSArray.hpp"
+#include "HAL/JSArrayBuffer.hpp"
+#include "HAL/JSTypedArray.hpp"
 
 #include "HAL/detail/JSPropertyNameAccumulator.hpp"
 #include "HAL/detail/JSUtil.hpp"
@@ -62,7 +66,7 @@ namespace HAL {
     return JSValue(js_context__, js_value_ref);
   }
   
-  void JSObject::SetProperty(const JSString& property_name, const JSValue& property_value, const std::unordered_set<JSPropertyAttribute>& attributes) {
+  void JSObject::SetProperty(const JSString& property_name, const JSValue& property_value, JSPropertyAttributeFlags attributes) {
     HAL_JSOBJECT_LOCK_GUARD;
     
     JSValueRef exception { nullptr };
@@ -82,6 +86,46 @@ namespace HAL {
     }
   }
   
+  JSExpected<JSValue> JSObject::TryGetProperty(const JSString& property_name) const {
+    HAL_JSOBJECT_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    const JSValueRef js_value_ref = JSObjectGetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_name), &exception);
+    if (exception) {
+      return JSExpected<JSValue>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSValue(js_context__, js_value_ref);
+  }
+  
+  JSExpected<JSValue> JSObject::TryGetProperty(unsigned property_index) const {
+    HAL_JSOBJECT_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    const JSValueRef js_value_ref = JSObjectGetPropertyAtIndex(static_cast<JSContextRef>(js_context__), js_object_ref__, property_index, &exception);
+    if (exception) {
+      return JSExpected<JSValue>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSValue(js_context__, js_value_ref);
+  }
+  
+  JSExpected<void> JSObject::TrySetProperty(const JSString& property_name, const JSValue& property_value, JSPropertyAttributeFlags attributes) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSObjectSetProperty(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSStringRef>(property_name), static_cast<JSValueRef>(property_value), detail::ToJSPropertyAttributes(attributes), &exception);
+    if (exception) {
+      return JSExpected<void>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSExpected<void>();
+  }
+  
+  JSExpected<void> JSObject::TrySetProperty(unsigned property_index, const JSValue& property_value) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSObjectSetPropertyAtIndex(static_cast<JSContextRef>(js_context__), js_object_ref__, property_index, static_cast<JSValueRef>(property_value), &exception);
+    if (exception) {
+      return JSExpected<void>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSExpected<void>();
+  }
+  
   bool JSObject::DeleteProperty(const JSString& property_name) {
     HAL_JSOBJECT_LOCK_GUARD;
     
@@ -152,6 +196,15 @@ namespace HAL {
     return static_cast<std::string>(self) == "[object Error]" || self.IsInstanceOfConstructor(error);
   }
   
+  bool JSObject::IsArrayBuffer() const HAL_NOEXCEPT {
+    return JSValueGetTypedArrayType(static_cast<JSContextRef>(js_context__), js_object_ref__, nullptr) == kJSTypedArrayTypeArrayBuffer;
+  }
+  
+  bool JSObject::IsTypedArray() const HAL_NOEXCEPT {
+    const auto type = JSValueGetTypedArrayType(static_cast<JSContextRef>(js_context__), js_object_ref__, nullptr);
+    return type != kJSTypedArrayTypeNone && type != kJSTypedArrayTypeArrayBuffer;
+  }
+  
   JSValue JSObject::operator()(                                        JSObject this_object) { return CallAsFunction(std::vector<JSValue>()                      , this_object); }
   JSValue JSObject::operator()(JSValue&                     argument , JSObject this_object) { return CallAsFunction({argument}                                  , this_object); }
   JSValue JSObject::operator()(const JSString&              argument , JSObject this_object) { return CallAsFunction(detail::to_vector(js_context__, {argument}) , this_object); }
@@ -206,6 +259,14 @@ namespace HAL {
     return JSObjectGetPrivate(js_object_ref__);
   }
   
+  bool JSObject::HasPrivateOfClass(const JSClass& js_class) const HAL_NOEXCEPT {
+    return JSValueIsObjectOfClass(static_cast<JSContextRef>(js_context__), js_object_ref__, static_cast<JSClassRef>(js_class));
+  }
+  
+  void JSObject::ThrowInvalidPrivate(const char* type_name) const {
+    detail::ThrowInvalidArgument("JSObject", "This JavaScript object does not have private data of type " + std::string(type_name) + ".");
+  }
+  
   bool JSObject::SetPrivate(void* data) const HAL_NOEXCEPT {
     UnRegisterPrivateData(GetPrivate());
     RegisterPrivateData(js_object_ref__, data);
@@ -286,6 +347,10 @@ namespace HAL {
   JSObject::operator JSError() const {
     return JSError(js_context__, js_object_ref__);
   }
+
+  JSObject::operator JSArrayBuffer() const {
+    return JSArrayBuffer(js_context__, js_object_ref__);
+  }
   
   JSValue JSObject::CallAsFunction(const std::vector<JSValue>&  arguments, JSObject this_object) {
     HAL_JSOBJECT_LOCK_GUARD;
@@ -314,6 +379,38 @@ namespace HAL {
     return JSValue(js_context__, js_value_ref);
   }
   
+  JSExpected<JSValue> JSObject::TryCallAsFunction(const std::vector<JSValue>& arguments, JSObject this_object) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    const auto context_ref = static_cast<JSContextRef>(js_context__);
+    if (!IsFunction()) {
+      return JSExpected<JSValue>(JSUnexpected(), JSValue(js_context__, detail::MakeTypeError(context_ref, "This JavaScript object is not a function.")));
+    }
+    
+    JSValueRef exception { nullptr };
+    const auto arguments_array = detail::to_vector(arguments);
+    const JSValueRef js_value_ref = JSObjectCallAsFunction(context_ref, js_object_ref__, static_cast<JSObjectRef>(this_object), arguments_array.size(), arguments_array.data(), &exception);
+    if (exception) {
+      return JSExpected<JSValue>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSValue(js_context__, js_value_ref);
+  }
+  
+  JSExpected<JSObject> JSObject::TryCallAsConstructor(const std::vector<JSValue>& arguments) {
+    HAL_JSOBJECT_LOCK_GUARD;
+    const auto context_ref = static_cast<JSContextRef>(js_context__);
+    if (!IsConstructor()) {
+      return JSExpected<JSObject>(JSUnexpected(), JSValue(js_context__, detail::MakeTypeError(context_ref, "This JavaScript object is not a constructor.")));
+    }
+    
+    JSValueRef exception { nullptr };
+    const auto arguments_array = detail::to_vector(arguments);
+    const JSObjectRef js_object_ref = JSObjectCallAsConstructor(context_ref, js_object_ref__, arguments_array.size(), arguments_array.data(), &exception);
+    if (exception) {
+      return JSExpected<JSObject>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSObject(js_context__, js_object_ref);
+  }
+  
   void JSObject::GetPropertyNames(const JSPropertyNameAccumulator& accumulator) const HAL_NOEXCEPT {
     HAL_JSOBJECT_LOCK_GUARD;
     for (const auto& property_name : static_cast<std::vector<JSString>>(GetPropertyNames())) {
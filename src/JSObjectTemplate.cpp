@@ -0,0 +1,83 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSObjectTemplate.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+#include <cassert>
+
+namespace HAL {
+
+  JSObjectTemplate::JSObjectTemplate(const JSContext& js_context, const std::vector<JSString>& property_names, JSPropertyAttributeFlags attributes)
+  : js_context__(js_context)
+  , property_names__(property_names)
+  , property_attributes__(property_names.size(), detail::ToJSPropertyAttributes(attributes)) {
+    HAL_LOG_TRACE("JSObjectTemplate:: ctor ", this);
+  }
+
+  JSObjectTemplate::JSObjectTemplate(const JSContext& js_context, std::initializer_list<JSString> property_names, JSPropertyAttributeFlags attributes)
+  : JSObjectTemplate(js_context, std::vector<JSString>(property_names), attributes) {
+  }
+
+  JSObjectTemplate::JSObjectTemplate(const JSContext& js_context, const std::vector<std::pair<JSString, JSPropertyAttributeFlags>>& properties)
+  : js_context__(js_context) {
+    HAL_LOG_TRACE("JSObjectTemplate:: ctor ", this);
+    property_names__.reserve(properties.size());
+    property_attributes__.reserve(properties.size());
+    for (const auto& property : properties) {
+      property_names__.push_back(property.first);
+      property_attributes__.push_back(detail::ToJSPropertyAttributes(property.second));
+    }
+  }
+
+  JSObject JSObjectTemplate::CreateObject(const std::vector<JSValue>& values) const {
+    const auto value_refs = detail::to_vector(values);
+    return MakeObject(value_refs.empty() ? nullptr : value_refs.data(), value_refs.size());
+  }
+
+  JSObject JSObjectTemplate::MakeObject(const JSValueRef values[], std::size_t count) const {
+    return JSObject(js_context__, MakeObjectRef(values, count));
+  }
+
+  void JSObjectTemplate::AppendObject(JSArrayBuilder& builder, const JSValueRef values[], std::size_t count) const {
+    builder.AppendJSValueRef(MakeObjectRef(values, count));
+  }
+
+  JSObjectRef JSObjectTemplate::MakeObjectRef(const JSValueRef values[], std::size_t count) const {
+    if (count != property_names__.size()) {
+      detail::ThrowInvalidArgument("JSObjectTemplate", "Expected " + std::to_string(property_names__.size()) + " property values but got " + std::to_string(count) + ".");
+    }
+
+    // Like JSContext::CreateObject, a plain object doesn't need a
+    // JSClass.
+    const auto context_ref = static_cast<JSContextRef>(js_context__);
+    JSObjectRef js_object_ref = JSObjectMake(context_ref, nullptr, nullptr);
+
+    for (std::size_t i = 0; i < count; ++i) {
+      JSValueRef exception { nullptr };
+      JSObjectSetProperty(context_ref, js_object_ref, static_cast<JSStringRef>(property_names__[i]), values[i], property_attributes__[i], &exception);
+      if (exception) {
+        detail::ThrowRuntimeError("JSObjectTemplate", JSValue(js_context__, exception));
+      }
+    }
+
+    return js_object_ref;
+  }
+
+  JSValueRef JSObjectTemplate::ToJSValueRef(JSContextRef context_ref, const char* string) HAL_NOEXCEPT {
+    JSStringRef js_string_ref = JSStringCreateWithUTF8CString(string);
+    JSValueRef  js_value_ref  = JSValueMakeString(context_ref, js_string_ref);
+    JSStringRelease(js_string_ref);
+    return js_value_ref;
+  }
+
+  JSValueRef JSObjectTemplate::ToJSValueRef(JSContextRef context_ref, const std::string& string) HAL_NOEXCEPT {
+    return ToJSValueRef(context_ref, string.c_str());
+  }
+
+} // namespace HAL {
@@ -0,0 +1,85 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSPromise.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+
+namespace HAL {
+
+  JSPromiseResolver::State::State(const JSContext& js_context, JSObjectRef resolve_ref, JSObjectRef reject_ref) HAL_NOEXCEPT
+  : js_context(js_context)
+  , resolve_ref(resolve_ref)
+  , reject_ref(reject_ref) {
+    const auto context_ref = static_cast<JSContextRef>(js_context);
+    JSValueProtect(context_ref, resolve_ref);
+    JSValueProtect(context_ref, reject_ref);
+  }
+
+  JSPromiseResolver::State::~State() HAL_NOEXCEPT {
+    Release();
+  }
+
+  void JSPromiseResolver::State::Release() HAL_NOEXCEPT {
+    if (!resolve_ref) {
+      return;
+    }
+    const auto context_ref = static_cast<JSContextRef>(js_context);
+    JSValueUnprotect(context_ref, resolve_ref);
+    JSValueUnprotect(context_ref, reject_ref);
+    resolve_ref = nullptr;
+    reject_ref  = nullptr;
+  }
+
+  JSPromiseResolver::JSPromiseResolver(const JSContext& js_context, JSObjectRef resolve_ref, JSObjectRef reject_ref)
+  : state__(std::make_shared<State>(js_context, resolve_ref, reject_ref)) {
+  }
+
+  bool JSPromiseResolver::Resolve() {
+    return Settle(true, JSValueMakeUndefined(static_cast<JSContextRef>(get_context())));
+  }
+
+  bool JSPromiseResolver::Reject(const JSValue& reason) {
+    return Settle(false, static_cast<JSValueRef>(reason));
+  }
+
+  bool JSPromiseResolver::Reject(const std::string& message) {
+    return Settle(false, detail::MakeError(static_cast<JSContextRef>(get_context()), message));
+  }
+
+  bool JSPromiseResolver::IsSettled() const HAL_NOEXCEPT {
+    return state__->resolve_ref == nullptr;
+  }
+
+  JSContext JSPromiseResolver::get_context() const HAL_NOEXCEPT {
+    return state__->js_context;
+  }
+
+  bool JSPromiseResolver::Settle(bool resolve, JSValueRef value_ref) {
+    if (IsSettled()) {
+      return false;
+    }
+
+    // Release the resolving functions before calling one, so that a
+    // reentrant Resolve, e.g. from a thenable, is ignored. The raw
+    // function is on the stack, where the garbage collector finds it.
+    const auto context_ref  = static_cast<JSContextRef>(state__->js_context);
+    const auto function_ref = resolve ? state__->resolve_ref : state__->reject_ref;
+    state__->Release();
+
+    JSValueRef exception { nullptr };
+    JSObjectCallAsFunction(context_ref, function_ref, nullptr, 1, &value_ref, &exception);
+
+    if (exception) {
+      detail::ThrowRuntimeError("JSPromiseResolver", JSValue(state__->js_context, exception));
+    }
+
+    return true;
+  }
+
+} // namespace HAL {
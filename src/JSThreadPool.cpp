@@ -0,0 +1,124 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSThreadPool.hpp"
+
+#include <algorithm>
+#include <exception>
+
+namespace HAL {
+
+  JSThreadPool::JSThreadPool(std::size_t thread_count) {
+    if (thread_count == 0) {
+      thread_count = std::max(1u, std::thread::hardware_concurrency());
+    }
+    threads__.reserve(thread_count);
+    for (std::size_t i = 0; i < thread_count; ++i) {
+      threads__.emplace_back(&JSThreadPool::Run, this);
+    }
+  }
+
+  JSThreadPool::~JSThreadPool() HAL_NOEXCEPT {
+    {
+      std::lock_guard<std::mutex> lock(mutex__);
+      stopping__ = true;
+    }
+    work_available__.notify_all();
+    for (auto& thread : threads__) {
+      thread.join();
+    }
+  }
+
+  void JSThreadPool::Post(std::function<void()> work, std::function<void()> completion) {
+    std::unique_ptr<Task> task(new Task());
+    task->work       = std::move(work);
+    task->completion = std::move(completion);
+    {
+      std::lock_guard<std::mutex> lock(mutex__);
+      work_queue__.push_back(std::move(task));
+      ++pending_count__;
+    }
+    work_available__.notify_one();
+  }
+
+  std::size_t JSThreadPool::RunCompletions(std::chrono::milliseconds timeout) {
+    std::deque<std::unique_ptr<Task>> completions;
+    {
+      std::unique_lock<std::mutex> lock(mutex__);
+      if (completion_queue__.empty() && pending_count__ > 0 && timeout.count() > 0) {
+        completion_available__.wait_for(lock, timeout, [this] { return !completion_queue__.empty(); });
+      }
+      completions.swap(completion_queue__);
+      pending_count__ -= completions.size();
+    }
+
+    // Every completion runs even if an earlier one throws.
+    std::exception_ptr exception;
+    for (const auto& task : completions) {
+      try {
+        if (task->completion) {
+          task->completion();
+        }
+      } catch (...) {
+        if (!exception) {
+          exception = std::current_exception();
+        }
+      }
+    }
+
+    if (exception) {
+      std::rethrow_exception(exception);
+    }
+
+    return completions.size();
+  }
+
+  void JSThreadPool::SetCompletionCallback(std::function<void()> completion_callback) {
+    std::lock_guard<std::mutex> lock(mutex__);
+    completion_callback__ = std::move(completion_callback);
+  }
+
+  std::size_t JSThreadPool::GetPendingCount() const {
+    std::lock_guard<std::mutex> lock(mutex__);
+    return pending_count__;
+  }
+
+  void JSThreadPool::Run() {
+    while (true) {
+      std::unique_ptr<Task> task;
+      {
+        std::unique_lock<std::mutex> lock(mutex__);
+        work_available__.wait(lock, [this] { return stopping__ || !work_queue__.empty(); });
+        if (stopping__) {
+          return;
+        }
+        task = std::move(work_queue__.front());
+        work_queue__.pop_front();
+      }
+
+      try {
+        if (task->work) {
+          task->work();
+        }
+      } catch (...) {
+      }
+
+      std::function<void()> completion_callback;
+      {
+        std::lock_guard<std::mutex> lock(mutex__);
+        completion_queue__.push_back(std::move(task));
+        completion_callback = completion_callback__;
+      }
+      completion_available__.notify_all();
+      if (completion_callback) {
+        completion_callback();
+      }
+    }
+  }
+
+} // namespace HAL {
@@ -0,0 +1,95 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/JSTypedArray.hpp"
+#include "HAL/JSValue.hpp"
+#include "HAL/detail/JSUtil.hpp"
+#include <string>
+#include <cassert>
+
+namespace HAL { namespace detail {
+
+JSTypedArrayType GetTypedArrayType(const JSContext& js_context, JSObjectRef js_object_ref) {
+	JSValueRef exception { nullptr };
+	const auto type = JSValueGetTypedArrayType(static_cast<JSContextRef>(js_context), js_object_ref, &exception);
+	if (exception) {
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+	return type;
+}
+
+JSObjectRef MakeTypedArray(const JSContext& js_context, JSTypedArrayType type, std::size_t length) {
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeTypedArray(static_cast<JSContextRef>(js_context), type, length, &exception);
+
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_object_ref.
+		assert(!js_object_ref);
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+
+	return js_object_ref;
+}
+
+JSObjectRef MakeTypedArrayWithArrayBuffer(const JSContext& js_context, JSTypedArrayType type, JSObjectRef js_array_buffer_ref, std::size_t byte_offset, std::size_t length) {
+	JSValueRef exception { nullptr };
+	JSObjectRef js_object_ref = JSObjectMakeTypedArrayWithArrayBufferAndOffset(static_cast<JSContextRef>(js_context), type, js_array_buffer_ref, byte_offset, length, &exception);
+
+	if (exception) {
+		// If this assert fails then we need to JSValueUnprotect
+		// js_object_ref.
+		assert(!js_object_ref);
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+
+	return js_object_ref;
+}
+
+void* GetTypedArrayBytesPtr(const JSContext& js_context, JSObjectRef js_object_ref) {
+	JSValueRef exception { nullptr };
+	void* bytes = JSObjectGetTypedArrayBytesPtr(static_cast<JSContextRef>(js_context), js_object_ref, &exception);
+	if (exception) {
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+	return bytes;
+}
+
+std::size_t GetTypedArrayLength(const JSContext& js_context, JSObjectRef js_object_ref) {
+	JSValueRef exception { nullptr };
+	const auto length = JSObjectGetTypedArrayLength(static_cast<JSContextRef>(js_context), js_object_ref, &exception);
+	if (exception) {
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+	return length;
+}
+
+std::size_t GetTypedArrayByteOffset(const JSContext& js_context, JSObjectRef js_object_ref) {
+	JSValueRef exception { nullptr };
+	const auto byte_offset = JSObjectGetTypedArrayByteOffset(static_cast<JSContextRef>(js_context), js_object_ref, &exception);
+	if (exception) {
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+	return byte_offset;
+}
+
+JSObjectRef GetTypedArrayBuffer(const JSContext& js_context, JSObjectRef js_object_ref) {
+	JSValueRef exception { nullptr };
+	JSObjectRef js_array_buffer_ref = JSObjectGetTypedArrayBuffer(static_cast<JSContextRef>(js_context), js_object_ref, &exception);
+	if (exception) {
+		assert(!js_array_buffer_ref);
+		ThrowRuntimeError("JSTypedArray", JSValue(js_context, exception));
+	}
+	return js_array_buffer_ref;
+}
+
+void ThrowInvalidTypedArray(const char* type_name) {
+	ThrowInvalidArgument("JSTypedArray", "This JavaScript object is not a typed array of " + std::string(type_name) + ".");
+}
+
+}} // namespace HAL { namespace detail {
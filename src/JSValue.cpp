@@ -24,6 +24,7 @@
 #include "HAL/JSRegExp.hpp"
 
 #include "HAL/JSClass.hpp"
+#include "HAL/JSExpected.hpp"
 
 #include "HAL/detail/JSUtil.hpp"
 
@@ -105,30 +106,7 @@ namespace HAL {
   
   JSValue::operator bool() const HAL_NOEXCEPT {
     HAL_JSVALUE_LOCK_GUARD;
-#ifdef HAL_USE_STRING_BOOLEAN_CONVERSION
-    // Use Java-like string to boolean conversion.
-    // This converts "false" string to false & "true" string to true unlike JavaScript standard.
-    static JSStringRef js_string_true_ref;
-    static JSStringRef js_string_false_ref;
-    static std::once_flag of;
-    std::call_once(of, [=] {   
-      js_string_true_ref  = JSStringCreateWithUTF8CString("true");
-      js_string_false_ref = JSStringCreateWithUTF8CString("false");
-    });
-    if (IsString()) {
-      const auto js_string_ref = JSValueToStringCopy(static_cast<JSContextRef>(js_context__), js_value_ref__, nullptr);
-      if (JSStringIsEqual(js_string_ref, js_string_true_ref)) {
-        JSStringRelease(js_string_ref);
-        return true;
-      }
-      if (JSStringIsEqual(js_string_ref, js_string_false_ref)) {
-        JSStringRelease(js_string_ref);
-        return false;
-      }
-      JSStringRelease(js_string_ref);
-    }
-#endif
-    return JSValueToBoolean(static_cast<JSContextRef>(js_context__), js_value_ref__);
+    return detail::to_bool(static_cast<JSContextRef>(js_context__), js_value_ref__);
   }
   
   JSValue::operator double() const {
@@ -147,6 +125,39 @@ namespace HAL {
     return detail::to_int32_t(operator double());
   }
   
+  JSExpected<JSString> JSValue::TryToString() const {
+    HAL_JSVALUE_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSStringRef js_string_ref = JSValueToStringCopy(static_cast<JSContextRef>(js_context__), js_value_ref__, &exception);
+    if (exception) {
+      return JSExpected<JSString>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    
+    JSString js_string(js_string_ref);
+    JSStringRelease(js_string_ref);
+    return js_string;
+  }
+  
+  JSExpected<double> JSValue::TryToNumber() const {
+    HAL_JSVALUE_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    const double result = JSValueToNumber(static_cast<JSContextRef>(js_context__), js_value_ref__, &exception);
+    if (exception) {
+      return JSExpected<double>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return result;
+  }
+  
+  JSExpected<JSObject> JSValue::TryToObject() const {
+    HAL_JSVALUE_LOCK_GUARD;
+    JSValueRef exception { nullptr };
+    JSObjectRef js_object_ref = JSValueToObject(static_cast<JSContextRef>(js_context__), js_value_ref__, &exception);
+    if (exception) {
+      return JSExpected<JSObject>(JSUnexpected(), JSValue(js_context__, exception));
+    }
+    return JSObject(js_context__, js_object_ref);
+  }
+  
   JSValue::operator JSObject() const {
     HAL_JSVALUE_LOCK_GUARD;
     JSValueRef exception { nullptr };
@@ -11,7 +11,7 @@
 
 namespace HAL { namespace detail {
   
-  JSPropertyCallback::JSPropertyCallback(const std::string& name, const std::unordered_set<JSPropertyAttribute>& attributes)
+  JSPropertyCallback::JSPropertyCallback(const std::string& name, JSPropertyAttributeFlags attributes)
   : name__(name)
   , attributes__(attributes) {
     
@@ -27,7 +27,7 @@ namespace HAL { namespace detail {
   
   JSPropertyCallback::JSPropertyCallback(JSPropertyCallback&& rhs) HAL_NOEXCEPT
   : name__(std::move(rhs.name__))
-  , attributes__(std::move(rhs.attributes__)) {
+  , attributes__(rhs.attributes__) {
   }
   
   JSPropertyCallback& JSPropertyCallback::operator=(const JSPropertyCallback& rhs) HAL_NOEXCEPT {
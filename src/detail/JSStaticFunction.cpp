@@ -14,7 +14,7 @@
 namespace HAL { namespace detail {
   
   JSStaticFunction::JSStaticFunction(const ::JSStaticFunction& js_static_function)
-  : JSPropertyCallback(js_static_function.name, FromJSPropertyAttributes(js_static_function.attributes))
+  : JSPropertyCallback(js_static_function.name, JSPropertyAttributeFlags::FromBits(js_static_function.attributes))
   , function_callback__(js_static_function.callAsFunction) {
     
     if (!function_callback__) {
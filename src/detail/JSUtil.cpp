@@ -12,24 +12,121 @@
 #include "HAL/JSObject.hpp"
 #include "HAL/JSError.hpp"
 #include "HAL/JSNumber.hpp"
+#include "HAL/JSExpected.hpp"
 
 #include <algorithm>
 #include <sstream>
 #include <stdexcept>
 #include <iterator>
+#include <mutex>
 
 #include <JavaScriptCore/JavaScript.h>
 
 
 namespace HAL { namespace detail {
 
-  js_runtime_error::js_runtime_error(const JSError& js_error) : std::runtime_error(js_error.message()) {
-    js_name__       = js_error.name();
-    js_filename__   = js_error.filename();
-    js_linenumber__ = js_error.linenumber();
-    js_stack__      = js_error.stack();
-    js_nativeStack__ = js_error.nativeStack();
-    js_message__    = js_error.message();
+  struct js_runtime_error::Properties {
+    Properties(const JSObject& js_error, const std::string& source_url, int line_number)
+    : js_error(js_error)
+    , source_url(source_url)
+    , line_number(line_number) {
+    }
+
+    // What is known when the exception is thrown. The native stack
+    // is only formatted inside exported functions, where it is not
+    // empty. Outside of them it is the Error's nativeStack, read on
+    // first access.
+    JSObject      js_error;
+    std::string   source_url;
+    int           line_number;
+    std::string   native_stack { JSError::HasNativeStack() ? JSError::GetNativeStack() : std::string() };
+
+    // The Error's properties, read on first access.
+    bool          materialized { false };
+    std::string   name;
+    std::string   message;
+    std::string   filename;
+    std::uint32_t linenumber { 0 };
+    std::string   stack;
+  };
+
+  js_runtime_error::js_runtime_error(const JSObject& js_error, const std::string& source_url, int line_number)
+  : std::runtime_error(std::string())
+  , properties__(std::make_shared<Properties>(js_error, source_url, line_number)) {
+  }
+
+  const js_runtime_error::Properties& js_runtime_error::GetProperties() const HAL_NOEXCEPT {
+    auto& properties = *properties__;
+    if (properties.materialized) {
+      return properties;
+    }
+    properties.materialized = true;
+
+    // A property whose getter or conversion throws reads as empty,
+    // since what() can't throw.
+    const auto& js_error = properties.js_error;
+    const auto get_string = [&js_error](const JSString& property_name) {
+      if (js_error.HasProperty(property_name)) {
+        const auto value = js_error.TryGetProperty(property_name);
+        const auto string = value ? value->TryToString() : JSExpected<JSString>(JSString());
+        if (string) {
+          return static_cast<std::string>(*string);
+        }
+      }
+      return std::string();
+    };
+
+    try {
+      properties.name     = get_string("name");
+      properties.message  = get_string("message");
+      properties.stack    = get_string("stack");
+      if (properties.native_stack.empty()) {
+        properties.native_stack = get_string("nativeStack");
+      }
+      properties.filename = js_error.HasProperty("fileName") ? get_string("fileName") : properties.source_url;
+      if (js_error.HasProperty("lineNumber")) {
+        const auto value  = js_error.TryGetProperty("lineNumber");
+        const auto number = value ? value->TryToNumber() : JSExpected<double>(0);
+        properties.linenumber = static_cast<std::uint32_t>(to_int32_t(number.GetValueOr(0)));
+      } else {
+        properties.linenumber = static_cast<std::uint32_t>(properties.line_number);
+      }
+    } catch (...) {
+    }
+
+    return properties;
+  }
+
+  const char* js_runtime_error::what() const HAL_NOEXCEPT {
+    return GetProperties().message.c_str();
+  }
+
+  JSObject js_runtime_error::js_error() const {
+    return properties__->js_error;
+  }
+
+  std::string js_runtime_error::js_name() const {
+    return GetProperties().name;
+  }
+
+  std::string js_runtime_error::js_message() const {
+    return GetProperties().message;
+  }
+
+  std::string js_runtime_error::js_filename() const {
+    return GetProperties().filename;
+  }
+
+  std::uint32_t js_runtime_error::js_linenumber() const {
+    return GetProperties().linenumber;
+  }
+
+  std::string js_runtime_error::js_stack() const {
+    return GetProperties().stack;
+  }
+
+  std::string js_runtime_error::js_nativeStack() const {
+    return GetProperties().native_stack;
   }
 
   void ThrowRuntimeError(const std::string& internal_component_name, const std::string& message) {
@@ -38,22 +135,13 @@ namespace HAL { namespace detail {
   }
   
   void ThrowRuntimeError(const std::string& internal_component_name, const JSValue& exception, const std::string& source_url, int line_number) {
-    // Check if exception is an error object
+    // An Error is thrown as is. Its Mozilla-like fileName and
+    // lineNumber default to where the script was evaluated when they
+    // are read.
     if (exception.IsObject()) {
       const auto js_exception = static_cast<JSObject>(exception);
       if (js_exception.IsError()) {
-        const auto js_context = js_exception.get_context();
-        auto js_error = static_cast<JSError>(js_exception);
-				
-        // Mozilla-like detailed properties to help debug
-        if (!js_error.HasProperty("fileName")) {
-            js_error.SetProperty("fileName", js_context.CreateString(source_url));
-        }
-        if (!js_error.HasProperty("lineNumber")) {
-          js_error.SetProperty("lineNumber", js_context.CreateNumber(line_number));
-        }	
-	
-        throw js_runtime_error(js_error);
+        throw js_runtime_error(js_exception, source_url, line_number);
       }
     }
 
@@ -175,8 +263,22 @@ namespace HAL { namespace detail {
     return result;
   }
   
+  std::string to_string(JSPropertyAttributeFlags attributes) HAL_NOEXCEPT {
+    std::string result;
+    for (auto attribute : {JSPropertyAttribute::None, JSPropertyAttribute::ReadOnly, JSPropertyAttribute::DontEnum, JSPropertyAttribute::DontDelete}) {
+      if (attributes.contains(attribute)) {
+        if (!result.empty()) {
+          result += ", ";
+        }
+        result += to_string(attribute);
+      }
+    }
+    
+    return result;
+  }
+  
   std::string to_string_JSPropertyAttributes(::JSPropertyAttributes attributes) HAL_NOEXCEPT {
-    return to_string(FromJSPropertyAttributes(attributes));
+    return to_string(JSPropertyAttributeFlags::FromBits(attributes));
   }
   
   unsigned ToJSClassAttribute(JSClassAttribute attribute) HAL_NOEXCEPT {
@@ -329,4 +431,73 @@ namespace HAL { namespace detail {
     return bits < 0 ? -result : result;
   }
   
+  bool to_array_index(JSStringRef property_name, uint32_t& index) HAL_NOEXCEPT {
+    const auto length = JSStringGetLength(property_name);
+    
+    // 4294967294 is the largest array index and has ten digits.
+    if (length == 0 || length > 10) {
+      return false;
+    }
+    
+    const JSChar* characters = JSStringGetCharactersPtr(property_name);
+    if (characters[0] == '0') {
+      if (length == 1) {
+        index = 0;
+        return true;
+      }
+      return false;
+    }
+    
+    uint64_t value = 0;
+    for (std::size_t i = 0; i < length; ++i) {
+      const auto digit = characters[i];
+      if (digit < '0' || digit > '9') {
+        return false;
+      }
+      value = value * 10 + (digit - '0');
+    }
+    
+    if (value > 4294967294ull) {
+      return false;
+    }
+    
+    index = static_cast<uint32_t>(value);
+    return true;
+  }
+  
+  bool to_bool(JSContextRef context_ref, JSValueRef js_value_ref) HAL_NOEXCEPT {
+#ifdef HAL_USE_STRING_BOOLEAN_CONVERSION
+    // Use Java-like string to boolean conversion.
+    // This converts "false" string to false & "true" string to true unlike JavaScript standard.
+    static JSStringRef js_string_true_ref;
+    static JSStringRef js_string_false_ref;
+    static std::once_flag of;
+    std::call_once(of, [=] {   
+      js_string_true_ref  = JSStringCreateWithUTF8CString("true");
+      js_string_false_ref = JSStringCreateWithUTF8CString("false");
+    });
+    if (JSValueIsString(context_ref, js_value_ref)) {
+      const auto js_string_ref = JSValueToStringCopy(context_ref, js_value_ref, nullptr);
+      if (JSStringIsEqual(js_string_ref, js_string_true_ref)) {
+        JSStringRelease(js_string_ref);
+        return true;
+      }
+      if (JSStringIsEqual(js_string_ref, js_string_false_ref)) {
+        JSStringRelease(js_string_ref);
+        return false;
+      }
+      JSStringRelease(js_string_ref);
+    }
+#endif
+    return JSValueToBoolean(context_ref, js_value_ref);
+  }
+  
+  JSClassRef CreateFunctionClass(JSObjectCallAsFunctionCallback call_as_function, JSObjectFinalizeCallback finalize) HAL_NOEXCEPT {
+    ::JSClassDefinition definition = kJSClassDefinitionEmpty;
+    definition.className      = "Function";
+    definition.callAsFunction = call_as_function;
+    definition.finalize       = finalize;
+    return ::JSClassCreate(&definition);
+  }
+  
 }} // namespace HAL { namespace detail {
@@ -9,6 +9,7 @@
 #include "HAL/HAL.hpp"
 
 #include "gtest/gtest.h"
+#include <algorithm>
 #include <chrono>
 #include <thread>
 
@@ -77,6 +78,52 @@ TEST_F(JSContextTests, JSEvaluateScriptWithError) {
   }
 }
 
+TEST_F(JSContextTests, JSRuntimeErrorReadsErrorLazily) {
+  JSContext js_context = js_context_group.CreateContext();
+  js_context.JSEvaluateScript("var thrown = new RangeError('too big');");
+  try {
+    js_context.JSEvaluateScript("throw thrown;", js_context.get_global_object(), "lazy.js", 7);
+    XCTAssertTrue(false);
+  } catch (const HAL::detail::js_runtime_error& e) {
+    // The Error is passed through untouched, and its properties are
+    // only read when they are asked for.
+    XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("!('fileName' in thrown) && !('lineNumber' in thrown);")));
+    XCTAssertTrue(e.js_error() == js_context.get_global_object().GetProperty("thrown"));
+    XCTAssertEqual("too big", std::string(e.what()));
+    XCTAssertEqual("RangeError", e.js_name());
+    XCTAssertEqual("lazy.js", e.js_filename());
+    XCTAssertEqual(7, e.js_linenumber());
+  }
+}
+
+TEST_F(JSContextTests, NativeStack) {
+  XCTAssertFalse(JSError::HasNativeStack());
+  {
+    const JSError::NativeStackFrame outer("Widget", "outer");
+    const JSError::NativeStackFrame inner("Widget", "inner");
+    XCTAssertEqual("1  JSExportClass<Widget>::inner\n2  JSExportClass<Widget>::outer\n", JSError::GetNativeStack());
+
+    // Each thread has its own native stack.
+    bool has_native_stack = true;
+    std::thread([&has_native_stack] { has_native_stack = JSError::HasNativeStack(); }).join();
+    XCTAssertFalse(has_native_stack);
+
+    // Only the innermost frames are kept.
+    const char* names[] = { "0", "1", "2", "3", "4", "5", "6", "7", "8", "9" };
+    for (const auto name : names) {
+      JSError::PushNativeStack("Widget", name);
+    }
+    const auto native_stack = JSError::GetNativeStack();
+    XCTAssertEqual(JSError::NativeStackCapacity, static_cast<std::size_t>(std::count(native_stack.begin(), native_stack.end(), '\n')));
+    XCTAssertTrue(native_stack.find("1  JSExportClass<Widget>::9\n") == 0);
+    XCTAssertEqual(std::string::npos, native_stack.find("outer"));
+    for (std::size_t i = 0; i < sizeof(names) / sizeof(names[0]); ++i) {
+      JSError::PopNativeStack();
+    }
+  }
+  XCTAssertFalse(JSError::HasNativeStack());
+}
+
 TEST_F(JSContextTests, JSContext) {
   JSContext js_context_1 = js_context_group.CreateContext();
   JSContext js_context_2 = js_context_group.CreateContext();
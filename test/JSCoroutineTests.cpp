@@ -0,0 +1,100 @@
+/**
+ * HAL
+ *
+ * Copyright (c) 2014 by Appcelerator, Inc. All Rights Reserved.
+ * Licensed under the terms of the Apache Public License.
+ * Please see the LICENSE included with this distribution for details.
+ */
+
+#include "HAL/HAL.hpp"
+#include "HAL/JSCoroutine.hpp"
+
+#include "gtest/gtest.h"
+
+#define XCTAssertEqual    ASSERT_EQ
+#define XCTAssertNotEqual ASSERT_NE
+#define XCTAssertTrue     ASSERT_TRUE
+#define XCTAssertFalse    ASSERT_FALSE
+
+using namespace HAL;
+
+#ifndef HAL_HAS_COROUTINES
+#error JSCoroutineTests must be built by a C++20 compiler with coroutine support.
+#endif
+
+namespace {
+  // The promise_type of a task is constructed from the coroutine's
+  // JSContext parameter, which the body itself does not need.
+  JSTask DoubleLater(const JSContext&, JSObject promise) {
+    const auto value = co_await JSAwait(promise);
+    co_return static_cast<double>(value) * 2;
+  }
+
+  JSVoidTask RecordLater(const JSContext&, JSObject promise, JSObject record) {
+    const auto value = co_await JSAwait(promise);
+    if (static_cast<double>(value) < 0) {
+      co_return;
+    }
+    record(std::vector<JSValue> { value }, record);
+  }
+}
+
+class JSCoroutineTests : public testing::Test {
+ protected:
+  virtual void SetUp() {
+  }
+  
+  virtual void TearDown() {
+  }
+  
+  JSContextGroup js_context_group;
+};
+
+TEST_F(JSCoroutineTests, JSTask) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  js_context.JSEvaluateScript("var results = []; function track(promise) { promise.then(function (v) { results.push('ok:' + v); }, function (e) { results.push('fail:' + e); }); }");
+  auto track = static_cast<JSObject>(global_object.GetProperty("track"));
+
+  // A coroutine returns its promise at the first co_await and
+  // settles it when it finishes.
+  auto fulfilled = js_context.CreatePromise();
+  auto rejected  = js_context.CreatePromise();
+  auto doubled   = DoubleLater(js_context, fulfilled.first);
+  auto failed    = DoubleLater(js_context, rejected.first);
+  track(std::vector<JSValue> { doubled.get_promise() }, global_object);
+  track(std::vector<JSValue> { failed.get_promise() }, global_object);
+  XCTAssertEqual("", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+
+  fulfilled.second.Resolve(21);
+  rejected.second.Reject("failed");
+  XCTAssertEqual("ok:42,fail:Error: failed", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+
+  // A value that is not a thenable is awaited without suspending.
+  auto immediate = DoubleLater(js_context, js_context.CreateObject());
+  track(std::vector<JSValue> { immediate.get_promise() }, global_object);
+  XCTAssertEqual("ok:42,fail:Error: failed,ok:NaN", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+}
+
+TEST_F(JSCoroutineTests, JSVoidTask) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  js_context.JSEvaluateScript("var results = []; function record(v) { results.push('record:' + v); } function track(promise) { promise.then(function (v) { results.push('ok:' + v); }, function (e) { results.push('fail:' + e); }); }");
+  auto record = static_cast<JSObject>(global_object.GetProperty("record"));
+  auto track  = static_cast<JSObject>(global_object.GetProperty("track"));
+
+  // Both a bare co_return and flowing off the end fulfill the promise
+  // with undefined.
+  auto returned = js_context.CreatePromise();
+  auto finished = js_context.CreatePromise();
+  auto rejected = js_context.CreatePromise();
+  track(std::vector<JSValue> { RecordLater(js_context, returned.first, record).get_promise() }, global_object);
+  track(std::vector<JSValue> { RecordLater(js_context, finished.first, record).get_promise() }, global_object);
+  track(std::vector<JSValue> { RecordLater(js_context, rejected.first, record).get_promise() }, global_object);
+  XCTAssertEqual("", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+
+  returned.second.Resolve(-1);
+  finished.second.Resolve(1);
+  rejected.second.Reject("failed");
+  XCTAssertEqual("ok:undefined,record:1,ok:undefined,fail:Error: failed", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+}
@@ -74,6 +74,18 @@ TEST_F(JSExportTests, JSExportClassDefinitionBuilder) {
   auto native_class = builder.build();
 }
 
+TEST_F(JSExportTests, SharedJSClass) {
+  // The JSClass for a JSExport class is created once and reused.
+  XCTAssertEqual(&JSExport<Widget>::Class(), &JSExport<Widget>::Class());
+  
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject widget1 = js_context.CreateObject(JSExport<Widget>::Class());
+  JSObject widget2 = js_context.CreateObject(JSExport<Widget>::Class());
+  XCTAssertTrue(static_cast<JSValue>(widget1).IsObjectOfClass(JSExport<Widget>::Class()));
+  XCTAssertTrue(static_cast<JSValue>(widget2).IsObjectOfClass(JSExport<Widget>::Class()));
+  XCTAssertFalse(static_cast<JSValue>(js_context.CreateObject()).IsObjectOfClass(JSExport<Widget>::Class()));
+}
+
 TEST_F(JSExportTests, JSExport) {
   JSContext js_context = js_context_group.CreateContext();
   JSObject global_object   = js_context.get_global_object();
@@ -236,6 +248,31 @@ TEST_F(JSExportTests, JSExportGetPrivate) {
   XCTAssertEqual(nullptr, wrong_widget_ptr2);
 }
 
+TEST_F(JSExportTests, JSExportGetPrivatePointer) {
+  JSContext js_context = js_context_group.CreateContext();
+  
+  JSObject widget       = js_context.CreateObject(JSExport<Widget>::Class());
+  JSObject other_widget = js_context.CreateObject(JSExport<OtherWidget>::Class());
+  JSObject child_widget = js_context.CreateObject(JSExport<ChildWidget>::Class());
+  
+  // Borrowed pointers refer to the same native object as GetPrivate.
+  auto widget_ptr = widget.GetPrivatePointer<Widget>();
+  XCTAssertNotEqual(nullptr, widget_ptr);
+  XCTAssertEqual(widget.GetPrivate<Widget>().get(), widget_ptr);
+  XCTAssertEqual(widget_ptr, &widget.GetPrivateReference<Widget>());
+  XCTAssertNotEqual(nullptr, other_widget.GetPrivatePointer<OtherWidget>());
+  
+  // A ChildWidget's JSClass derives from Widget's JSClass.
+  XCTAssertNotEqual(nullptr, child_widget.GetPrivatePointer<ChildWidget>());
+  XCTAssertEqual(static_cast<Widget*>(child_widget.GetPrivatePointer<ChildWidget>()), child_widget.GetPrivatePointer<Widget>());
+  
+  // The class id check rejects the wrong native type.
+  XCTAssertEqual(nullptr, widget.GetPrivatePointer<OtherWidget>());
+  XCTAssertEqual(nullptr, widget.GetPrivatePointer<ChildWidget>());
+  XCTAssertEqual(nullptr, js_context.CreateObject().GetPrivatePointer<Widget>());
+  ASSERT_THROW(other_widget.GetPrivateReference<Widget>(), std::invalid_argument);
+}
+
 TEST_F(JSExportTests, JSExportConstructorCount) {
   JSContext js_context = js_context_group.CreateContext();
   JSObject global_object = js_context.get_global_object();
@@ -352,6 +389,145 @@ TEST_F(JSExportTests, ExportObjectToJSArray) {
   XCTAssertEqual(static_cast<JSObject>(args.at(3)).GetPrivate<Widget>().get(), export_items.at(3).get());
 }
 
+TEST_F(JSExportTests, ExportObjectPointersFromJSArray) {
+  JSContext js_context = js_context_group.CreateContext();
+
+  std::vector<JSValue> args = {
+    js_context.CreateObject(JSExport<Widget>::Class()),
+    js_context.CreateNumber(42),
+    js_context.CreateObject(JSExport<OtherWidget>::Class()),
+    js_context.CreateObject(JSExport<ChildWidget>::Class()),
+    js_context.CreateObject()
+  };
+
+  JSArray js_array = js_context.CreateArray(args);
+
+  // Elements are matched by JSClass, so derived classes match their
+  // base class and everything else is nullptr.
+  auto widgets = js_array.GetPrivatePointers<Widget>();
+  XCTAssertEqual(5, widgets.size());
+  XCTAssertEqual(static_cast<JSObject>(args.at(0)).GetPrivatePointer<Widget>(), widgets.at(0));
+  XCTAssertEqual(nullptr, widgets.at(1));
+  XCTAssertEqual(nullptr, widgets.at(2));
+  XCTAssertEqual(static_cast<JSObject>(args.at(3)).GetPrivatePointer<Widget>(), widgets.at(3));
+  XCTAssertNotEqual(nullptr, widgets.at(3));
+  XCTAssertEqual(nullptr, widgets.at(4));
+
+  // Filling caller-provided storage stops at the smaller of the two
+  // lengths.
+  OtherWidget* other_widgets[3] = { nullptr, nullptr, nullptr };
+  XCTAssertEqual(3, js_array.GetPrivatePointers(other_widgets, 3));
+  XCTAssertEqual(nullptr, other_widgets[0]);
+  XCTAssertEqual(nullptr, other_widgets[1]);
+  XCTAssertEqual(static_cast<JSObject>(args.at(2)).GetPrivatePointer<OtherWidget>(), other_widgets[2]);
+
+  // Spans more than one internal chunk.
+  std::vector<JSValue> many_args;
+  for (int i = 0; i < 130; ++i) {
+    many_args.push_back(js_context.CreateObject(JSExport<Widget>::Class()));
+  }
+  JSArray many_widgets = js_context.CreateArray(many_args);
+  auto many_widget_ptrs = many_widgets.GetPrivatePointers<Widget>();
+  XCTAssertEqual(130, many_widget_ptrs.size());
+  for (std::size_t i = 0; i < many_args.size(); ++i) {
+    XCTAssertEqual(static_cast<JSObject>(many_args.at(i)).GetPrivatePointer<Widget>(), many_widget_ptrs.at(i));
+  }
+}
+
+TEST_F(JSExportTests, JSNativeIterator) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+
+  // A native range is iterable with for...of and spread.
+  const std::vector<int32_t> numbers = { 1, 2, 3, 4, 5 };
+  global_object.SetProperty("numbers", js_context.CreateIterator(numbers.begin(), numbers.end(), [&js_context](int32_t number) {
+    return static_cast<JSValue>(js_context.CreateNumber(number));
+  }));
+  XCTAssertEqual(15, static_cast<int32_t>(js_context.JSEvaluateScript("var sum = 0; for (var n of numbers) { sum += n; } sum;")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("var result = numbers.next(); result.done && result.value === undefined;")));
+
+  global_object.SetProperty("spread", js_context.CreateIterator(numbers.begin(), numbers.end(), [&js_context](int32_t number) {
+    return static_cast<JSValue>(js_context.CreateNumber(number * 2));
+  }));
+  XCTAssertEqual("[2,4,6,8,10]", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify([...spread]);")));
+
+  // Values are pulled lazily, and leaving a loop early releases the
+  // source.
+  auto pulled = std::make_shared<int32_t>(0);
+  global_object.SetProperty("generator", js_context.CreateIterator([pulled, &js_context](JSValue& value) {
+    value = js_context.CreateNumber(++*pulled);
+    return true;
+  }));
+  XCTAssertEqual(2, pulled.use_count());
+  XCTAssertEqual(3, static_cast<int32_t>(js_context.JSEvaluateScript("var last; for (var g of generator) { last = g; if (g === 3) break; } last;")));
+  XCTAssertEqual(3, *pulled);
+  XCTAssertEqual(1, pulled.use_count());
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("generator.next().done;")));
+}
+
+TEST_F(JSExportTests, JSEventEmitter) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  auto emitter_object = js_context.CreateEventEmitter();
+  global_object.SetProperty("emitter", emitter_object);
+  auto& emitter = emitter_object.GetPrivateReference<JSEventEmitter>();
+
+  js_context.JSEvaluateScript("var log = [];"
+                              "function a(x, y) { log.push('a' + x + y); }"
+                              "function b(x) { log.push('b' + x + (this === emitter)); }"
+                              "emitter.on('tick', a).on('tick', b).once('tick', function (x) { log.push('once' + x); });");
+  XCTAssertEqual(3, emitter.GetListenerCount("tick"));
+
+  // Listeners are called in order with the same arguments, and once
+  // listeners only the first time.
+  XCTAssertTrue(emitter.Emit("tick", {js_context.CreateNumber(1), js_context.CreateString("x")}));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("emitter.emit('tick', 2, 'y');")));
+  XCTAssertEqual("a1x,b1true,once1,a2y,b2true", static_cast<std::string>(js_context.JSEvaluateScript("log.join();")));
+  XCTAssertEqual(2, static_cast<int32_t>(js_context.JSEvaluateScript("emitter.listenerCount('tick');")));
+
+  // A listener removed during an emit is not called by it.
+  js_context.JSEvaluateScript("log = []; emitter.off('tick', a).on('tick', function c() { emitter.off('tick', b); emitter.off('tick', c); log.push('c'); }).emit('tick', 3);");
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("emitter.emit('none');")));
+  XCTAssertEqual("b3true,c", static_cast<std::string>(js_context.JSEvaluateScript("log.join();")));
+  XCTAssertEqual(0, emitter.GetListenerCount("tick"));
+
+  // Every listener is called before the listeners' errors are
+  // reported together.
+  js_context.JSEvaluateScript("log = []; emitter.on('fail', function () { throw new Error('one'); }).on('fail', a).on('fail', function () { throw 'two'; });");
+  std::vector<JSValue> errors;
+  XCTAssertTrue(emitter.Emit("fail", {js_context.CreateNumber(4), js_context.CreateNumber(5)}, errors));
+  XCTAssertEqual(2, errors.size());
+  XCTAssertEqual("Error: one", static_cast<std::string>(errors.at(0)));
+  XCTAssertEqual("two", static_cast<std::string>(errors.at(1)));
+  XCTAssertEqual("AggregateError: 2 listeners of 'fail' threw: Error: one; two", static_cast<std::string>(js_context.JSEvaluateScript("try { emitter.emit('fail', 6, 7); } catch (e) { e.name + ': ' + e.message; }")));
+  XCTAssertEqual("a45,a67", static_cast<std::string>(js_context.JSEvaluateScript("log.join();")));
+
+  emitter.RemoveAllListeners("fail");
+  XCTAssertFalse(emitter.Emit("fail"));
+  ASSERT_THROW(emitter.On("tick", js_context.CreateObject()), std::invalid_argument);
+}
+
+TEST_F(JSExportTests, AsyncFunctionProperty) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  global_object.SetProperty("widget", js_context.CreateObject(JSExport<Widget>::Class()));
+  js_context.JSEvaluateScript("var results = []; function track(promise) { promise.then(function (v) { results.push('ok:' + v); }, function (e) { results.push('fail:' + e); }); }");
+
+  // The calls return promises right away; bad arguments reject them
+  // without running the member function.
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("widget.repeatAsync('ab', 3) instanceof Promise;")));
+  js_context.JSEvaluateScript("results = []; track(widget.repeatAsync('ab', 3)); track(widget.repeatAsync('ab', 0)); track(widget.repeatAsync(1, 2)); track(widget.repeatAsync('ab'));");
+  XCTAssertEqual("fail:TypeError: Argument 1 must be a string.,fail:TypeError: Expected 2 arguments but got 1.", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+
+  // The results settle the promises on this thread, in order on the
+  // single pool thread, once the completions run.
+  const auto thread_pool = Widget::GetThreadPool();
+  while (thread_pool->GetPendingCount() > 0) {
+    thread_pool->RunCompletions(std::chrono::milliseconds(1000));
+  }
+  XCTAssertEqual("fail:TypeError: Argument 1 must be a string.,fail:TypeError: Expected 2 arguments but got 1.,ok:ababab,fail:Error: count must be positive", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+}
+
 TEST_F(JSExportTests, InitializeWithProperties) {
   JSContext js_context = js_context_group.CreateContext();
 
@@ -1308,8 +1484,11 @@ TEST_F(JSExportTests, ExceptionCall) {
     XCTAssertEqual("app.js", e.js_filename());
     XCTAssertEqual(123, e.js_linenumber());
     XCTAssertNotEqual("", e.js_stack());
-    XCTAssertNotEqual("", e.js_nativeStack());
+    XCTAssertNotEqual(std::string::npos, e.js_nativeStack().find("testException"));
   }
+
+  // The frame is popped even though the exported function threw.
+  XCTAssertFalse(JSError::HasNativeStack());
 }
 
 TEST_F(JSExportTests, ExceptionCall2) {
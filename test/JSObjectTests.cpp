@@ -10,6 +10,13 @@
 
 #include "gtest/gtest.h"
 
+#include <cmath>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <thread>
+
 #define XCTAssertEqual    ASSERT_EQ
 #define XCTAssertNotEqual ASSERT_NE
 #define XCTAssertTrue     ASSERT_TRUE
@@ -57,6 +64,34 @@ TEST_F(JSObjectTests, JSPropertyAttribute) {
   XCTAssertEqual(1, attributes.size());
 }
 
+TEST_F(JSObjectTests, JSPropertyAttributeFlags) {
+  constexpr auto read_only_dont_delete = JSPropertyAttribute::ReadOnly | JSPropertyAttribute::DontDelete;
+  static_assert(read_only_dont_delete.contains(JSPropertyAttribute::ReadOnly), "ReadOnly must be set");
+  static_assert(!read_only_dont_delete.contains(JSPropertyAttribute::DontEnum), "DontEnum must not be set");
+  static_assert(read_only_dont_delete.bits() == (kJSPropertyAttributeReadOnly | kJSPropertyAttributeDontDelete), "bits must match JavaScriptCore");
+  
+  JSPropertyAttributeFlags attributes;
+  XCTAssertTrue(attributes.empty());
+  XCTAssertEqual(1, attributes.count(JSPropertyAttribute::None));
+  XCTAssertTrue(attributes.insert(JSPropertyAttribute::DontEnum));
+  XCTAssertFalse(attributes.insert(JSPropertyAttribute::DontEnum));
+  XCTAssertEqual(0, attributes.count(JSPropertyAttribute::None));
+  XCTAssertEqual(1, attributes.count(JSPropertyAttribute::DontEnum));
+  
+  // Source compatibility with std::unordered_set<JSPropertyAttribute>.
+  const std::unordered_set<JSPropertyAttribute> attribute_set { JSPropertyAttribute::ReadOnly, JSPropertyAttribute::DontDelete };
+  XCTAssertTrue(read_only_dont_delete == JSPropertyAttributeFlags(attribute_set));
+  XCTAssertTrue(read_only_dont_delete == JSPropertyAttributeFlags({JSPropertyAttribute::ReadOnly, JSPropertyAttribute::DontDelete}));
+  XCTAssertTrue(attribute_set == static_cast<std::unordered_set<JSPropertyAttribute>>(read_only_dont_delete));
+  
+  JSContext js_context = js_context_group.CreateContext();
+  JSObject js_object = js_context.CreateObject();
+  js_object.SetProperty("foo", js_context.CreateNumber(42), read_only_dont_delete);
+  js_object.SetProperty("bar", js_context.CreateNumber(42), attribute_set);
+  XCTAssertFalse(js_object.DeleteProperty("foo"));
+  XCTAssertFalse(js_object.DeleteProperty("bar"));
+}
+
 TEST_F(JSObjectTests, JSObject_ptr_t) {
   JSContext js_context = js_context_group.CreateContext();
   JSObject js_object = js_context.CreateObject();
@@ -393,6 +428,16 @@ TEST_F(JSObjectTests, BoolVectorFromJSArray) {
   XCTAssertTrue(items.at(0));
   XCTAssertFalse(items.at(1));
   XCTAssertTrue(items.at(2));
+
+  // Elements, including "false", are converted like
+  // static_cast<bool>(JSValue), and holes are false.
+  const auto mixed_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("[0, 'a', , NaN, {}, 'false', 'true'];")));
+  const auto mixed = static_cast<std::vector<bool>>(mixed_array);
+  XCTAssertEqual(7, mixed.size());
+  for (uint32_t i = 0; i < mixed.size(); ++i) {
+    XCTAssertEqual(static_cast<bool>(mixed_array.GetProperty(i)), mixed.at(i));
+  }
+  XCTAssertFalse(mixed.at(2));
 }
 
 TEST_F(JSObjectTests, DoubleVectorFromJSArray) {
@@ -462,6 +507,448 @@ TEST_F(JSObjectTests, UIntVectorFromJSArray) {
   XCTAssertEqual(123, items.at(1));
 }
 
+TEST_F(JSObjectTests, JSArrayBuilder) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  JSArrayBuilder builder(js_context, 8);
+  builder.AppendNumber(UnitTestConstants::pi)
+         .AppendBoolean(true)
+         .AppendString("hello")
+         .AppendString(std::string("world"))
+         .AppendString(JSString("!"))
+         .AppendNull()
+         .AppendUndefined()
+         .Append(js_context.CreateObject());
+  XCTAssertEqual(8, builder.GetLength());
+  
+  auto js_array = builder.Build();
+  XCTAssertEqual(0, builder.GetLength());
+  XCTAssertTrue(js_array.IsArray());
+  XCTAssertEqual(8, js_array.GetLength());
+  global_object.SetProperty("built", js_array);
+  XCTAssertEqual("[3.141592653589793,true,\"hello\",\"world\",\"!\",null,null,{}]", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(built);")));
+  
+  // The builder can be reused after Build.
+  for (int32_t i = 0; i < 1000; ++i) {
+    builder.AppendNumber(i);
+  }
+  js_array = builder.Build();
+  XCTAssertEqual(1000, js_array.GetLength());
+  XCTAssertEqual(999, static_cast<int32_t>(js_array.GetProperty(999)));
+  
+  XCTAssertEqual(0, JSArrayBuilder(js_context).Build().GetLength());
+}
+
+TEST_F(JSObjectTests, JSObjectTemplate) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  JSObjectTemplate point_template(js_context, {"id", "name", "x", "y"});
+  XCTAssertEqual(4, point_template.GetPropertyCount());
+  XCTAssertEqual("name", static_cast<std::string>(point_template.GetPropertyNames().at(1)));
+  
+  // Native values, tuples and JSValues all produce the same object.
+  global_object.SetProperty("a", point_template.CreateObject(1, "one", 1.5, true));
+  global_object.SetProperty("b", point_template.CreateObject(std::make_tuple(2, std::string("two"), 2.5, false)));
+  global_object.SetProperty("c", point_template.CreateObject(std::vector<JSValue> { js_context.CreateNumber(3), js_context.CreateString("three"), js_context.CreateNull(), js_context.CreateObject() }));
+  XCTAssertEqual("{\"id\":1,\"name\":\"one\",\"x\":1.5,\"y\":true}", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(a);")));
+  XCTAssertEqual("{\"id\":2,\"name\":\"two\",\"x\":2.5,\"y\":false}", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(b);")));
+  XCTAssertEqual("{\"id\":3,\"name\":\"three\",\"x\":null,\"y\":{}}", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(c);")));
+  
+  ASSERT_THROW(point_template.CreateObject(1, "one"), std::invalid_argument);
+  
+  // A braced list of two names is a list of names, not a range.
+  JSObjectTemplate pair_template(js_context, {"x", "y"});
+  XCTAssertEqual(2, pair_template.GetPropertyCount());
+  XCTAssertEqual("{\"x\":1,\"y\":2}", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(this);", pair_template.CreateObject(1, 2))));
+  
+  // Per-property attributes are applied to every object.
+  JSObjectTemplate readonly_template(js_context, {{"id", JSPropertyAttribute::ReadOnly}, {"name", JSPropertyAttribute::DontEnum}});
+  global_object.SetProperty("d", readonly_template.CreateObject(4, "four"));
+  XCTAssertEqual(4, static_cast<int32_t>(js_context.JSEvaluateScript("d.id = 5; d.id;")));
+  XCTAssertEqual("[\"id\"]", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(Object.keys(d));")));
+  
+  // Arrays of records are stamped in bulk.
+  struct Record {
+    int32_t     id;
+    std::string name;
+    double      x;
+    double      y;
+  };
+  std::vector<Record> records;
+  for (int32_t i = 0; i < 1000; ++i) {
+    records.push_back(Record { i, "record" + std::to_string(i), i * 0.5, i * 2.0 });
+  }
+  auto js_array = point_template.CreateArray(records.begin(), records.end(), [](const Record& record) {
+    return std::tie(record.id, record.name, record.x, record.y);
+  });
+  XCTAssertEqual(1000, js_array.GetLength());
+  global_object.SetProperty("records", js_array);
+  XCTAssertEqual("{\"id\":999,\"name\":\"record999\",\"x\":499.5,\"y\":1998}", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(records[999]);")));
+  
+  std::vector<std::tuple<int32_t, const char*, double, double>> tuples = { std::make_tuple(7, "seven", 0.0, 1.0) };
+  XCTAssertEqual(1, point_template.CreateArray(tuples).GetLength());
+}
+
+namespace {
+  // A document of records { "id": i, "tags": [ "tag0", ... ] } that
+  // counts how many properties and elements were read.
+  class RecordsNode final : public JSDocumentNode {
+  public:
+    RecordsNode(std::size_t length, std::shared_ptr<std::size_t> visits) : length__(length), visits__(visits) {
+    }
+    
+    bool IsArray() const override {
+      return true;
+    }
+    
+    std::size_t GetLength() const override {
+      return length__;
+    }
+    
+    bool VisitElement(std::size_t index, JSDocumentVisitor& visitor) const override;
+    
+  private:
+    std::size_t                  length__;
+    std::shared_ptr<std::size_t> visits__;
+  };
+  
+  class RecordNode final : public JSDocumentNode {
+  public:
+    RecordNode(std::size_t id, std::shared_ptr<std::size_t> visits) : id__(id), visits__(visits) {
+    }
+    
+    std::vector<std::string> GetPropertyNames() const override {
+      return { "id", "name", "tags" };
+    }
+    
+    bool VisitProperty(const std::string& property_name, JSDocumentVisitor& visitor) const override {
+      ++*visits__;
+      if (property_name == "id") {
+        visitor.VisitNumber(static_cast<double>(id__));
+      } else if (property_name == "name") {
+        visitor.VisitString("record" + std::to_string(id__));
+      } else if (property_name == "tags") {
+        visitor.VisitNode(std::make_shared<RecordsNode>(2, visits__));
+      } else if (property_name == "throws") {
+        throw std::runtime_error("native failure");
+      } else {
+        return false;
+      }
+      return true;
+    }
+    
+    bool HasProperty(const std::string& property_name) const override {
+      return property_name == "throws" || JSDocumentNode::HasProperty(property_name);
+    }
+    
+  private:
+    std::size_t                  id__;
+    std::shared_ptr<std::size_t> visits__;
+  };
+  
+  bool RecordsNode::VisitElement(std::size_t index, JSDocumentVisitor& visitor) const {
+    ++*visits__;
+    visitor.VisitNode(std::make_shared<RecordNode>(index, visits__));
+    return true;
+  }
+}
+
+TEST_F(JSObjectTests, JSDocumentProxy) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  auto visits = std::make_shared<std::size_t>(0);
+  auto root   = std::make_shared<RecordsNode>(1000000, visits);
+  auto js_document = js_context.CreateDocumentProxy(root);
+  XCTAssertEqual(root, JSDocumentProxy::GetNode(js_document));
+  XCTAssertEqual(nullptr, JSDocumentProxy::GetNode(js_context.CreateObject()));
+  global_object.SetProperty("doc", js_document);
+  
+  // Only the properties a script reads are converted.
+  XCTAssertEqual(1000000, static_cast<int32_t>(js_context.JSEvaluateScript("doc.length;")));
+  XCTAssertEqual("record42", static_cast<std::string>(js_context.JSEvaluateScript("doc[42].name;")));
+  XCTAssertEqual(2, *visits);
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("Array.isArray(doc) || doc.map !== undefined;")));
+  
+  // Cached children keep their identity, and the document is read-only.
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("doc[7] === doc[7];")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("7 in doc && doc[7].id === 7;")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("doc[7] = 1; delete doc[7]; typeof doc[7] === 'object' && doc[7].id === 7;")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("var tags = doc[5].tags; doc[5].tags = null; delete doc[5].tags; doc[5].tags === tags && Object.keys(doc[5]).join() === 'id,name,tags';")));
+  XCTAssertEqual(7, static_cast<int32_t>(js_context.JSEvaluateScript("doc[7].id = 8; doc[7].id;")));
+  XCTAssertEqual("[\"id\",\"name\",\"tags\"]", static_cast<std::string>(js_context.JSEvaluateScript("JSON.stringify(Object.keys(doc[7]));")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("'id' in doc[3] && !('missing' in doc[3]);")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("doc[3].missing === undefined;")));
+  
+  // Without caching every read creates a new child proxy.
+  global_object.SetProperty("uncached", js_context.CreateDocumentProxy(root, false));
+  XCTAssertFalse(static_cast<bool>(js_context.JSEvaluateScript("uncached[7] === uncached[7];")));
+  
+  // Native exceptions become JavaScript exceptions.
+  XCTAssertEqual("native failure", static_cast<std::string>(js_context.JSEvaluateScript("var message; try { doc[1].throws; } catch (e) { message = e.message; } message;")));
+  
+  ASSERT_THROW(js_context.CreateDocumentProxy(nullptr), std::invalid_argument);
+}
+
+TEST_F(JSObjectTests, JSArrayLazyIteration) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto js_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("var a = []; for (var i = 0; i < 10; ++i) { a.push(i); } a;")));
+  
+  int32_t total = 0;
+  for (const auto js_value : js_array) {
+    total += static_cast<int32_t>(js_value);
+  }
+  XCTAssertEqual(45, total);
+  
+  auto first = js_array.begin();
+  XCTAssertEqual(10, js_array.end() - first);
+  XCTAssertEqual(3, static_cast<int32_t>(first[3]));
+  first += 5;
+  XCTAssertEqual(5, static_cast<int32_t>(*first));
+  XCTAssertEqual(5, first.get_index());
+  XCTAssertTrue(first < js_array.end());
+  
+  std::vector<uint32_t> chunk_starts;
+  std::vector<std::size_t> chunk_sizes;
+  total = 0;
+  auto visited = js_array.ForEachChunk(4, [&](uint32_t first_index, const std::vector<JSValue>& chunk) {
+    chunk_starts.push_back(first_index);
+    chunk_sizes.push_back(chunk.size());
+    for (const auto& js_value : chunk) {
+      total += static_cast<int32_t>(js_value);
+    }
+    return true;
+  });
+  XCTAssertEqual(10, visited);
+  XCTAssertEqual(45, total);
+  XCTAssertTrue((std::vector<uint32_t> { 0, 4, 8 }) == chunk_starts);
+  XCTAssertTrue((std::vector<std::size_t> { 4, 4, 2 }) == chunk_sizes);
+  
+  // Stop after the first chunk.
+  visited = js_array.ForEachChunk(3, [](uint32_t, const std::vector<JSValue>&) {
+    return false;
+  });
+  XCTAssertEqual(3, visited);
+}
+
+TEST_F(JSObjectTests, JSArrayBulkNumbers) {
+  JSContext js_context = js_context_group.CreateContext();
+  
+  const std::vector<double> values { 1.5, -2, 3e10, 0 };
+  auto js_array = js_context.CreateArrayFromNumbers(values);
+  XCTAssertTrue(js_array.IsArray());
+  XCTAssertFalse(js_array.IsTypedArray());
+  XCTAssertEqual(4, js_array.GetLength());
+  XCTAssertTrue(values == static_cast<std::vector<double>>(js_array));
+  
+  std::vector<double> doubles;
+  js_array.CopyNumbersTo(doubles);
+  XCTAssertTrue(values == doubles);
+  
+  // Integers must be exactly representable in the native type.
+  std::vector<int32_t> int32s;
+  ASSERT_THROW(js_array.CopyNumbersTo(int32s), std::invalid_argument);
+  js_array = js_context.CreateArrayFromNumbers(std::vector<int32_t> { 7, -8, 9 });
+  js_array.CopyNumbersTo(int32s);
+  XCTAssertTrue((std::vector<int32_t> { 7, -8, 9 }) == int32s);
+  std::vector<uint32_t> uint32s;
+  ASSERT_THROW(js_array.CopyNumbersTo(uint32s), std::invalid_argument);
+  
+  // Holes and non-numbers are rejected by the checked copy but keep
+  // their ToNumber conversion in the std::vector operators.
+  js_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("[1, , 3];")));
+  ASSERT_THROW(js_array.CopyNumbersTo(doubles), std::invalid_argument);
+  XCTAssertTrue(std::isnan(static_cast<std::vector<double>>(js_array).at(1)));
+  js_array = static_cast<JSArray>(static_cast<JSObject>(js_context.JSEvaluateScript("[1, '2', 3];")));
+  ASSERT_THROW(js_array.CopyNumbersTo(doubles), std::invalid_argument);
+  XCTAssertEqual(2, static_cast<std::vector<int32_t>>(js_array).at(1));
+  
+  const std::vector<double> empty;
+  js_array = js_context.CreateArrayFromNumbers(empty);
+  XCTAssertEqual(0, js_array.GetLength());
+  js_array.CopyNumbersTo(doubles);
+  XCTAssertTrue(doubles.empty());
+}
+
+TEST_F(JSObjectTests, JSNativeArray) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  auto table = std::make_shared<std::vector<double>>(std::vector<double> { 1, 2, 3, 4 });
+  auto js_table = js_context.CreateNativeArray(table);
+  global_object.SetProperty("table", js_table);
+  XCTAssertTrue(table == JSNativeArray<double>::GetStorage(js_table));
+  XCTAssertTrue(nullptr == JSNativeArray<int32_t>::GetStorage(js_table));
+  XCTAssertTrue(nullptr == JSNativeArray<double>::GetStorage(js_context.CreateObject()));
+  
+  XCTAssertEqual(4, static_cast<int32_t>(js_context.JSEvaluateScript("table.length;")));
+  XCTAssertEqual(3, static_cast<int32_t>(js_context.JSEvaluateScript("table[2];")));
+  XCTAssertTrue(js_context.JSEvaluateScript("table[4];").IsUndefined());
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("3 in table && !(4 in table);")));
+  XCTAssertEqual(10, static_cast<int32_t>(js_context.JSEvaluateScript("table.reduce(function(a, b) { return a + b; }, 0);")));
+  XCTAssertEqual("0,1,2,3", static_cast<std::string>(js_context.JSEvaluateScript("Object.keys(table).join();")));
+  
+  // Writes go to the native vector and native changes are visible
+  // without copying.
+  js_context.JSEvaluateScript("table[0] = 42; table.length = 0;");
+  XCTAssertEqual(42, table->at(0));
+  XCTAssertEqual(4, table->size());
+  table->push_back(5);
+  XCTAssertEqual(5, static_cast<int32_t>(js_context.JSEvaluateScript("table.length;")));
+  
+  // Non-canonical indices are ordinary properties.
+  js_context.JSEvaluateScript("table['01'] = 7;");
+  XCTAssertEqual(2, table->at(1));
+  
+  // The vector can't grow, and indices past the end stay empty.
+  js_context.JSEvaluateScript("table[10] = 5; table.push(6);");
+  XCTAssertEqual(5, table->size());
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("table[10] === undefined && !(10 in table) && table[5] === undefined;")));
+  
+  // 64-bit integers are written exactly, and booleans follow the
+  // rule of static_cast<bool>(JSValue).
+  auto ids = std::make_shared<std::vector<int64_t>>(2);
+  global_object.SetProperty("ids", js_context.CreateNativeArray(ids));
+  js_context.JSEvaluateScript("ids[0] = Math.pow(2, 40) + 1; ids[1] = -Math.pow(2, 40);");
+  XCTAssertEqual(1099511627777LL, ids->at(0));
+  XCTAssertEqual(-1099511627776LL, ids->at(1));
+  auto flags = std::make_shared<std::vector<bool>>(1);
+  global_object.SetProperty("flags", js_context.CreateNativeArray(flags));
+  js_context.JSEvaluateScript("flags[0] = 'false';");
+  XCTAssertEqual(static_cast<bool>(js_context.CreateString("false")), flags->at(0));
+  
+  auto names = std::make_shared<std::vector<std::string>>(std::vector<std::string> { "a", "b" });
+  global_object.SetProperty("names", js_context.CreateNativeArray(names));
+  js_context.JSEvaluateScript("names[1] = names[0] + 'c';");
+  XCTAssertEqual("ac", names->at(1));
+  
+  ASSERT_THROW(js_context.CreateNativeArray(std::shared_ptr<std::vector<double>>()), std::invalid_argument);
+}
+
+TEST_F(JSObjectTests, JSTypedArray) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  const std::vector<float> values { 1.5f, 2.5f, 3.5f, 4.5f };
+  auto js_float32_array = js_context.CreateTypedArray(values);
+  XCTAssertTrue(js_float32_array.IsTypedArray());
+  XCTAssertFalse(js_float32_array.IsArrayBuffer());
+  XCTAssertFalse(js_float32_array.IsArray());
+  XCTAssertEqual(4, js_float32_array.size());
+  XCTAssertEqual(2.5f, js_float32_array[1]);
+  XCTAssertTrue(values == static_cast<std::vector<float>>(js_float32_array));
+  
+  // Writes through the native view are visible to JavaScript.
+  global_object.SetProperty("floats", js_float32_array);
+  js_float32_array[0] = 42;
+  XCTAssertEqual(42, static_cast<int32_t>(js_context.JSEvaluateScript("floats[0];")));
+  js_context.JSEvaluateScript("floats[3] = 7;");
+  XCTAssertEqual(7.0f, js_float32_array.data()[3]);
+  
+  // Convert from a typed array created by JavaScript.
+  auto js_object = static_cast<JSObject>(js_context.JSEvaluateScript("new Float64Array([1, 2, 3]);"));
+  XCTAssertTrue(js_object.IsTypedArray());
+  JSFloat64Array js_float64_array = static_cast<JSFloat64Array>(js_object);
+  double sum = 0;
+  for (const auto value : js_float64_array) {
+    sum += value;
+  }
+  XCTAssertEqual(6, sum);
+  ASSERT_THROW(static_cast<JSInt32Array>(js_object), std::invalid_argument);
+  ASSERT_THROW(static_cast<JSFloat64Array>(js_context.CreateArray()), std::invalid_argument);
+}
+
+TEST_F(JSObjectTests, JSArrayBuffer) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  const uint8_t bytes[] { 1, 2, 3, 4, 5, 6, 7, 8 };
+  auto js_array_buffer = js_context.CreateArrayBuffer(bytes, sizeof(bytes));
+  XCTAssertTrue(js_array_buffer.IsArrayBuffer());
+  XCTAssertFalse(js_array_buffer.IsTypedArray());
+  XCTAssertEqual(sizeof(bytes), js_array_buffer.size());
+  XCTAssertEqual(0, std::memcmp(bytes, js_array_buffer.data(), sizeof(bytes)));
+  
+  global_object.SetProperty("buffer", js_array_buffer);
+  XCTAssertEqual(8, static_cast<int32_t>(js_context.JSEvaluateScript("buffer.byteLength;")));
+  XCTAssertEqual(3, static_cast<int32_t>(js_context.JSEvaluateScript("new Uint8Array(buffer)[2];")));
+  
+  // A typed array view shares the bytes of its ArrayBuffer.
+  auto js_uint8_array = js_context.CreateTypedArray<uint8_t>(js_array_buffer, 4, 2);
+  XCTAssertEqual(2, js_uint8_array.size());
+  XCTAssertEqual(4, js_uint8_array.GetByteOffset());
+  XCTAssertEqual(5, js_uint8_array[0]);
+  js_uint8_array[1] = 60;
+  XCTAssertEqual(60, static_cast<uint8_t*>(js_array_buffer.data())[5]);
+  XCTAssertEqual(js_array_buffer.data(), js_uint8_array.GetArrayBuffer().data());
+  
+  auto js_zeroed_buffer = js_context.CreateArrayBuffer(16);
+  XCTAssertEqual(16, js_zeroed_buffer.size());
+  XCTAssertEqual(0, static_cast<uint8_t*>(js_zeroed_buffer.data())[15]);
+  
+  auto js_object = static_cast<JSObject>(js_context.JSEvaluateScript("new ArrayBuffer(4);"));
+  XCTAssertEqual(4, static_cast<JSArrayBuffer>(js_object).size());
+  ASSERT_THROW(static_cast<JSArrayBuffer>(js_context.CreateObject()), std::runtime_error);
+}
+
+TEST_F(JSObjectTests, JSArrayBufferWithBytesNoCopy) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  // JavaScript reads and writes the native memory in place.
+  auto pixels = std::make_shared<std::vector<uint8_t>>(4, 255);
+  auto js_array_buffer = js_context.CreateArrayBufferWithBytesNoCopy(pixels->data(), pixels->size(), pixels);
+  XCTAssertEqual(static_cast<void*>(pixels->data()), js_array_buffer.data());
+  XCTAssertEqual(2, pixels.use_count());
+  global_object.SetProperty("pixels", js_array_buffer);
+  js_context.JSEvaluateScript("new Uint8Array(pixels)[1] = 7;");
+  XCTAssertEqual(7, pixels->at(1));
+  
+  // The deallocator runs when the buffer is finalized, which may be
+  // after this test returns unless its context group is released, so
+  // it only records the pointer it was given.
+  static uint8_t bytes[] { 1, 2, 3 };
+  auto released = std::make_shared<void*>(nullptr);
+  {
+    JSContextGroup bytes_context_group;
+    JSContext bytes_context = bytes_context_group.CreateContext();
+    auto js_bytes = bytes_context.CreateArrayBufferWithBytesNoCopy(bytes, sizeof(bytes), [released](void* bytes_ptr) {
+      *released = bytes_ptr;
+    });
+    XCTAssertEqual(3, js_bytes.size());
+    XCTAssertEqual(nullptr, *released);
+  }
+  XCTAssertEqual(static_cast<void*>(bytes), *released);
+}
+
+TEST_F(JSObjectTests, JSArrayBufferFromFile) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  const std::string path = "JSArrayBufferFromFile.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    file << "HAL";
+  }
+  
+  auto js_array_buffer = js_context.CreateArrayBufferFromFile(path);
+  XCTAssertEqual(3, js_array_buffer.size());
+  XCTAssertEqual(0, std::memcmp("HAL", js_array_buffer.data(), 3));
+  
+  // Writes from JavaScript stay private to the ArrayBuffer.
+  global_object.SetProperty("file", js_array_buffer);
+  js_context.JSEvaluateScript("new Uint8Array(file)[0] = 0x68;");
+  XCTAssertEqual('h', static_cast<char*>(js_array_buffer.data())[0]);
+  std::ifstream file(path, std::ios::binary);
+  std::string contents((std::istreambuf_iterator<char>(file)), std::istreambuf_iterator<char>());
+  XCTAssertEqual("HAL", contents);
+  
+  ASSERT_THROW(js_context.CreateArrayBufferFromFile(path + ".missing"), std::runtime_error);
+  std::remove(path.c_str());
+}
+
 TEST_F(JSObjectTests, JSDate) {
   JSContext js_context = js_context_group.CreateContext();
   JSDate js_date = js_context.CreateDate();
@@ -565,6 +1052,283 @@ TEST_F(JSObjectTests, JSFunctionCallback) {
   XCTAssertTrue(noop_function(noop_function).IsUndefined());
 }
 
+TEST_F(JSObjectTests, JSTypedFunction) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  
+  global_object.SetProperty("add", js_context.CreateFunction<double(double, double)>("add", [](double x, double y) {
+    return x + y;
+  }));
+  global_object.SetProperty("repeat", js_context.CreateFunction<std::string(const std::string&, int32_t)>([](const std::string& string, int32_t count) {
+    std::string result;
+    for (int32_t i = 0; i < count; ++i) {
+      result += string;
+    }
+    return result;
+  }));
+  global_object.SetProperty("keys", js_context.CreateFunction<JSValue(JSObject, bool)>([&js_context](JSObject js_object, bool sorted) {
+    return js_context.JSEvaluateScript(sorted ? "Object.keys(this).sort().join()" : "Object.keys(this).join()", js_object);
+  }));
+  auto called = std::make_shared<bool>(false);
+  global_object.SetProperty("touch", js_context.CreateFunction<void()>([called]() {
+    *called = true;
+  }));
+  global_object.SetProperty("isEven", js_context.CreateFunction<bool(int64_t)>([](int64_t number) {
+    return number % 2 == 0;
+  }));
+  global_object.SetProperty("rethrow", js_context.CreateFunction<void(const std::string&)>([&js_context](const std::string& script) {
+    js_context.JSEvaluateScript(script);
+  }));
+  global_object.SetProperty("fail", js_context.CreateFunction<int32_t(int32_t)>([](int32_t) -> int32_t {
+    throw std::runtime_error("native failure");
+  }));
+  
+  XCTAssertEqual(3.5, static_cast<double>(js_context.JSEvaluateScript("add(1, 2.5);")));
+  XCTAssertEqual("add", static_cast<std::string>(js_context.JSEvaluateScript("add.name;")));
+  XCTAssertEqual(6, static_cast<int32_t>(js_context.JSEvaluateScript("add.call(null, 2, 4);")));
+  XCTAssertEqual("ababab", static_cast<std::string>(js_context.JSEvaluateScript("repeat('ab', 3);")));
+  XCTAssertEqual("a,b", static_cast<std::string>(js_context.JSEvaluateScript("keys({ b: 1, a: 2 }, true);")));
+  XCTAssertTrue(js_context.JSEvaluateScript("touch();").IsUndefined());
+  XCTAssertTrue(*called);
+  
+  // Arity and type mismatches throw a TypeError without calling the
+  // native function.
+  const std::string check = "function check(f) { try { f(); return 'none'; } catch (e) { return e.name + ': ' + e.message; } }";
+  js_context.JSEvaluateScript(check);
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("isEven(-Math.pow(2, 63));")));
+  XCTAssertEqual("TypeError: Argument 1 must be an integer in range.", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return isEven(Math.pow(2, 63)); });")));
+  XCTAssertEqual("TypeError: Expected 2 arguments but got 1.", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return add(1); });")));
+  XCTAssertEqual("TypeError: Argument 2 must be a number.", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return add(1, '2'); });")));
+  XCTAssertEqual("TypeError: Argument 2 must be an integer in range.", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return repeat('ab', 1.5); });")));
+  XCTAssertEqual("TypeError: Argument 1 must be an object.", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return keys(1, true); });")));
+  XCTAssertEqual("Error: native failure", static_cast<std::string>(js_context.JSEvaluateScript("check(function () { return fail(1); });")));
+  
+  // A script's Error passes through a native function untouched.
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("var thrown = new RangeError('inner'); try { rethrow('throw thrown;'); false; } catch (e) { e === thrown; }")));
+}
+
+TEST_F(JSObjectTests, JSFunctionCallbackLifetime) {
+  auto calls = std::make_shared<int32_t>(0);
+  
+  // Releasing the group at the end of the scope finalizes every
+  // function, which a garbage collection can't promise since the
+  // collector is conservative.
+  {
+    JSContextGroup callback_context_group;
+    JSContext js_context = callback_context_group.CreateContext();
+    auto global_object = js_context.get_global_object();
+    
+    JSFunctionCallback callback = [calls](const std::vector<JSValue> arguments, JSObject& this_object) {
+      ++*calls;
+      return this_object.get_context().CreateNumber(static_cast<int32_t>(arguments.size()));
+    };
+    
+    {
+      JSFunction js_function = js_context.CreateFunction("countArguments", callback);
+      
+      // Copies share the same JavaScript function.
+      JSFunction js_function_copy(js_function);
+      XCTAssertTrue(static_cast<JSValue>(js_function) == static_cast<JSValue>(js_function_copy));
+      global_object.SetProperty("countArguments", js_function_copy);
+    }
+    
+    // The callback outlives every JSFunction wrapper.
+    XCTAssertEqual(2, static_cast<int32_t>(js_context.JSEvaluateScript("countArguments(1, 2);")));
+    XCTAssertEqual(3, static_cast<int32_t>(js_context.JSEvaluateScript("countArguments.call(null, 1, 2, 3);")));
+    XCTAssertEqual(1, static_cast<int32_t>(js_context.JSEvaluateScript("countArguments.bind(null, 1)();")));
+    XCTAssertEqual("countArguments", static_cast<std::string>(js_context.JSEvaluateScript("countArguments.name;")));
+    XCTAssertEqual("function", static_cast<std::string>(js_context.JSEvaluateScript("typeof countArguments;")));
+    XCTAssertEqual(3, *calls);
+    
+    // The function owns its copy of the callback.
+    XCTAssertEqual(3, calls.use_count());
+    callback = nullptr;
+    global_object.DeleteProperty("countArguments");
+  }
+  
+  // Finalizing the function destroyed its copy of the callback.
+  XCTAssertEqual(1, calls.use_count());
+}
+
+TEST_F(JSObjectTests, JSArgumentsCallback) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+
+  global_object.SetProperty("scale", js_context.CreateFunction("scale", JSArgumentsCallback([](const JSArguments& arguments, JSObject& this_object) {
+    const double factor = arguments.IsUndefined(1) ? 2 : arguments.ToNumber(1);
+    return this_object.get_context().CreateNumber(arguments.ToNumber(0) * factor);
+  })));
+  global_object.SetProperty("describe", js_context.CreateFunction("describe", JSArgumentsCallback([](const JSArguments& arguments, JSObject& this_object) {
+    std::string result = std::to_string(arguments.size());
+    for (std::size_t i = 0; i < arguments.size(); ++i) {
+      result += arguments.IsString(i) ? " string:" + arguments.ToString(i) : " " + arguments.ToString(i);
+    }
+    return this_object.get_context().CreateString(result);
+  })));
+  global_object.SetProperty("second", js_context.CreateFunction("second", JSArgumentsCallback([](const JSArguments& arguments, JSObject&) {
+    return arguments[1];
+  })));
+
+  XCTAssertEqual(5, static_cast<int32_t>(js_context.JSEvaluateScript("scale(2.5);")));
+  XCTAssertEqual(-9, static_cast<int32_t>(js_context.JSEvaluateScript("scale(3, -3);")));
+  XCTAssertEqual("scale", static_cast<std::string>(js_context.JSEvaluateScript("scale.name;")));
+  XCTAssertEqual("3 string:a 1 true", static_cast<std::string>(js_context.JSEvaluateScript("describe('a', 1, true);")));
+  XCTAssertEqual("0", static_cast<std::string>(js_context.JSEvaluateScript("describe();")));
+  XCTAssertEqual("b", static_cast<std::string>(js_context.JSEvaluateScript("second.apply(null, ['a', 'b']);")));
+  XCTAssertTrue(js_context.JSEvaluateScript("second('a');").IsUndefined());
+
+  // An argument kept by the callback is protected by its JSValue.
+  XCTAssertEqual("[object Object]", static_cast<std::string>(js_context.JSEvaluateScript("String(second(1, {}));")));
+
+  // A JavaScript exception thrown by a conversion is rethrown.
+  XCTAssertEqual("Error: valueOf", static_cast<std::string>(js_context.JSEvaluateScript("try { scale({ valueOf: function () { throw 'valueOf'; } }); } catch (e) { String(e); }")));
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("var thrown = new RangeError('valueOf'); try { scale({ valueOf: function () { throw thrown; } }); false; } catch (e) { e === thrown; }")));
+}
+
+TEST_F(JSObjectTests, JSExpected) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+
+  auto result = js_context.TryEvaluateScript("6 * 7;");
+  XCTAssertTrue(result.HasValue());
+  XCTAssertEqual(42, static_cast<int32_t>(*result));
+
+  // Whatever the script throws is returned untouched.
+  result = js_context.TryEvaluateScript("throw { code: 7 };");
+  XCTAssertFalse(result);
+  XCTAssertTrue(result.GetException().IsObject());
+  XCTAssertEqual(7, static_cast<int32_t>(static_cast<JSObject>(result.GetException()).GetProperty("code")));
+  ASSERT_THROW(result.GetValue(), std::runtime_error);
+
+  js_context.JSEvaluateScript("var guarded = { get value() { throw new RangeError('no'); }, set value(v) { throw 'read only'; } };");
+  js_context.JSEvaluateScript("function add(a, b) { return a + b; } function Point(x) { this.x = x; }");
+  auto guarded = static_cast<JSObject>(global_object.GetProperty("guarded"));
+  const auto property = guarded.TryGetProperty("value");
+  XCTAssertFalse(property);
+  XCTAssertEqual("RangeError: no", static_cast<std::string>(property.GetException()));
+  const auto set = guarded.TrySetProperty("value", js_context.CreateNumber(1));
+  XCTAssertFalse(set);
+  XCTAssertEqual("read only", static_cast<std::string>(set.GetException()));
+  XCTAssertTrue(global_object.TrySetProperty("answer", js_context.CreateNumber(42)));
+  XCTAssertEqual(42, static_cast<int32_t>(global_object.TryGetProperty("answer").GetValue()));
+
+  auto add = static_cast<JSObject>(global_object.GetProperty("add"));
+  XCTAssertEqual(3, static_cast<int32_t>(*add.TryCallAsFunction({js_context.CreateNumber(1), js_context.CreateNumber(2)}, global_object)));
+  auto point = static_cast<JSObject>(global_object.GetProperty("Point")).TryCallAsConstructor({js_context.CreateNumber(5)});
+  XCTAssertEqual(5, static_cast<int32_t>(point->GetProperty("x")));
+  const auto not_a_function = guarded.TryCallAsFunction({}, global_object);
+  XCTAssertEqual("TypeError: This JavaScript object is not a function.", static_cast<std::string>(not_a_function.GetException()));
+
+  auto coercible = js_context.JSEvaluateScript("({ valueOf: function () { throw 'no number'; }, toString: function () { return 'text'; } });");
+  XCTAssertEqual("no number", static_cast<std::string>(coercible.TryToNumber().GetException()));
+  XCTAssertEqual(-1.0, coercible.TryToNumber().GetValueOr(-1.0));
+  XCTAssertEqual("text", static_cast<std::string>(*coercible.TryToString()));
+  XCTAssertFalse(js_context.CreateNull().TryToObject());
+}
+
+TEST_F(JSObjectTests, JSPromise) {
+  JSContext js_context = js_context_group.CreateContext();
+  auto global_object = js_context.get_global_object();
+  js_context.JSEvaluateScript("var results = []; function track(promise) { promise.then(function (v) { results.push('ok:' + v); }, function (e) { results.push('fail:' + e); }); }");
+  auto track = static_cast<JSObject>(global_object.GetProperty("track"));
+
+  auto number = js_context.CreatePromise();
+  auto text   = js_context.CreatePromise();
+  auto error  = js_context.CreatePromise();
+  global_object.SetProperty("pending", number.first);
+  XCTAssertTrue(static_cast<bool>(js_context.JSEvaluateScript("pending instanceof Promise;")));
+  for (auto promise : { number.first, text.first, error.first }) {
+    track(std::vector<JSValue> { promise }, global_object);
+  }
+  XCTAssertEqual("", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+
+  // Native results are converted directly, and only the first call
+  // settles a promise.
+  XCTAssertFalse(number.second.IsSettled());
+  XCTAssertTrue(number.second.Resolve(42));
+  XCTAssertTrue(number.second.IsSettled());
+  XCTAssertFalse(number.second.Reject("too late"));
+  auto text_resolver = text.second;
+  XCTAssertTrue(text_resolver.Resolve(std::string("done")));
+  XCTAssertTrue(text.second.IsSettled());
+  XCTAssertTrue(error.second.Reject("failed"));
+
+  XCTAssertEqual("ok:42,ok:done,fail:Error: failed", static_cast<std::string>(js_context.JSEvaluateScript("results.join();")));
+}
+
+TEST_F(JSObjectTests, JSCallBatcher) {
+  JSContext js_context = js_context_group.CreateContext();
+  js_context.JSEvaluateScript("var batches = []; function onEvents(events) { batches.push(events.join()); }");
+  js_context.JSEvaluateScript("var log = []; function record(a, b) { log.push(a + ':' + b); } function fail() { throw 'fail'; }");
+  const auto global_object = js_context.get_global_object();
+  const auto on_events = static_cast<JSObject>(global_object.GetProperty("onEvents"));
+  const auto record    = static_cast<JSObject>(global_object.GetProperty("record"));
+  const auto fail      = static_cast<JSObject>(global_object.GetProperty("fail"));
+
+  // Events are delivered together once there are max_batch_size of
+  // them, or by an explicit Flush.
+  JSCallBatcher events(js_context, on_events, 3);
+  for (int32_t i = 1; i <= 4; ++i) {
+    events.Enqueue(js_context.CreateNumber(i));
+  }
+  XCTAssertEqual(1, events.GetPendingCount());
+  XCTAssertEqual("1,2,3", static_cast<std::string>(js_context.JSEvaluateScript("batches.join('|');")));
+  events.Flush();
+  events.Flush();
+  XCTAssertEqual(0, events.GetPendingCount());
+  XCTAssertEqual("1,2,3|4", static_cast<std::string>(js_context.JSEvaluateScript("batches.join('|');")));
+  ASSERT_THROW(events.Enqueue(record), std::invalid_argument);
+
+  // Queued calls are made in order by one JavaScript loop, and a
+  // failing call does not stop the others.
+  JSCallBatcher calls(js_context);
+  calls.Enqueue(record, {js_context.CreateString("a"), js_context.CreateNumber(1)});
+  calls.Enqueue(fail);
+  calls.Enqueue(record, {js_context.CreateString("b")});
+  XCTAssertEqual(3, calls.GetPendingCount());
+  XCTAssertEqual("", static_cast<std::string>(js_context.JSEvaluateScript("log.join();")));
+  ASSERT_THROW(calls.Flush(), std::runtime_error);
+  XCTAssertEqual("a:1,b:undefined", static_cast<std::string>(js_context.JSEvaluateScript("log.join();")));
+  XCTAssertEqual(0, calls.GetPendingCount());
+  ASSERT_THROW(calls.Enqueue(js_context.CreateNumber(1)), std::invalid_argument);
+  ASSERT_THROW(calls.Enqueue(js_context.CreateObject()), std::invalid_argument);
+
+  // A call that has waited max_delay is flushed by FlushIfDue.
+  JSCallBatcher delayed(js_context, on_events, 0, std::chrono::milliseconds(1));
+  XCTAssertFalse(delayed.FlushIfDue());
+  delayed.Enqueue(js_context.CreateNumber(5));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  XCTAssertTrue(delayed.FlushIfDue());
+  XCTAssertEqual("1,2,3|4|5", static_cast<std::string>(js_context.JSEvaluateScript("batches.join('|');")));
+}
+
+TEST_F(JSObjectTests, JSCallable) {
+  JSContext js_context = js_context_group.CreateContext();
+  JSFunction js_function = js_context.CreateFunction("return a + b;", {"a", "b"});
+  JSCallable add(js_function);
+
+  XCTAssertEqual(3, static_cast<int32_t>(add(js_context.CreateNumber(1), js_context.CreateNumber(2))));
+  XCTAssertEqual(7, static_cast<int32_t>(add.Invoke({js_context.CreateNumber(3), js_context.CreateNumber(4)})));
+
+  // The argument buffer is reused between calls.
+  int32_t total = 0;
+  for (int32_t i = 0; i < 100; ++i) {
+    total = static_cast<int32_t>(add(js_context.CreateNumber(total), js_context.CreateNumber(i)));
+  }
+  XCTAssertEqual(4950, total);
+
+  // The receiver is fixed when the callable is prepared.
+  auto this_object = js_context.CreateObject();
+  this_object.SetProperty("value", js_context.CreateNumber(42));
+  JSCallable get_value(js_context.CreateFunction("return this.value;"), this_object);
+  XCTAssertEqual(42, static_cast<int32_t>(get_value()));
+
+  JSCallable thrower(js_context.CreateFunction("throw new Error('boom');"));
+  ASSERT_THROW(thrower(), std::runtime_error);
+
+  ASSERT_THROW(JSCallable(js_context.CreateObject()), std::runtime_error);
+}
+
 TEST_F(JSObjectTests, JSON_stringify) {
   auto js_context = js_context_group.CreateContext();
   auto global_object = js_context.get_global_object();